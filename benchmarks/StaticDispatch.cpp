@@ -0,0 +1,139 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file StaticDispatch.cpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Compares virtual and static dispatch when drawing a menu
+ * 
+ * @details Draws a menu holding 10 000 components into an off-screen
+ * texture, through virtual calls, with static dispatch and with batching,
+ * and prints the average CPU time spent per frame. Pass the path of a font
+ * as the first argument to include buttons and labels in the menu, whose
+ * glyphs are batched per font.
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/System/Clock.hpp>
+
+#include <Separator.hpp>
+#include <CheckBox.hpp>
+#include <Button.hpp>
+#include <Label.hpp>
+#include <Menu.hpp>
+
+using easyGUI::Menu;
+using easyGUI::Point;
+
+static const uint32_t COMPONENT_COUNT = 10000;
+static const uint32_t WARMUP_FRAMES = 30;
+static const uint32_t MEASURED_FRAMES = 300;
+
+static void populate(Menu& menu, const ::std::string& fontPath) {
+    const uint32_t kinds = fontPath.empty() ? 2 : 4;
+
+    for (uint32_t i = 0; i < COMPONENT_COUNT; ++i) {
+        const Point location(static_cast<float>((i * 37) % 1880),
+                             static_cast<float>((i * 53) % 1040));
+        const ::std::string ID = "component" + ::std::to_string(i);
+
+        switch (i % kinds) {
+            case 0:
+                menu.addComponent(::std::make_shared<easyGUI::CheckBox>(
+                    location, 20.0f, 20.0f), ID);
+                break;
+            case 1:
+                menu.addComponent(::std::make_shared<easyGUI::Separator>(
+                    location, i % 3 == 0, 40.0f, 2), ID);
+                break;
+            case 2:
+                menu.addComponent(::std::make_shared<easyGUI::Label>(
+                    location, "Label", fontPath, 12), ID);
+                break;
+            default:
+                menu.addComponent(::std::make_shared<easyGUI::Button>(
+                    location, 60.0f, 20.0f, "Button", fontPath, 12), ID);
+                break;
+        }
+    }
+}
+
+static double measure(::sf::RenderTexture& target, Menu& menu) {
+    for (uint32_t i = 0; i < WARMUP_FRAMES; ++i) {
+        target.clear();
+        target.draw(menu);
+        target.display();
+        menu.clearDirty();
+    }
+
+    ::sf::Time total = ::sf::Time::Zero;
+
+    for (uint32_t i = 0; i < MEASURED_FRAMES; ++i) {
+        target.clear();
+
+        ::sf::Clock clock;
+        target.draw(menu);
+        total += clock.getElapsedTime();
+
+        target.display();
+        menu.clearDirty();
+    }
+
+    return static_cast<double>(total.asMicroseconds()) / MEASURED_FRAMES;
+}
+
+int main(int argc, char** argv) {
+    const ::std::string fontPath = argc > 1 ? argv[1] : "";
+
+    ::sf::RenderTexture target;
+
+    if (!target.create(1920, 1080)) {
+        ::std::cerr << "Could not create the render texture.\n";
+        return 1;
+    }
+
+    Menu menu;
+    populate(menu, fontPath);
+
+    menu.setStaticDispatch(false);
+    const double virtualTime = measure(target, menu);
+
+    menu.setStaticDispatch(true);
+    const double staticTime = measure(target, menu);
+
+    menu.setBatching(true);
+    const double batchedTime = measure(target, menu);
+
+    ::std::cout << COMPONENT_COUNT << " components, "
+                << MEASURED_FRAMES << " frames\n"
+                << "virtual dispatch: " << virtualTime << " us / frame\n"
+                << "static dispatch:  " << staticTime << " us / frame\n"
+                << "batched:          " << batchedTime << " us / frame, "
+                << menu.getBatchCount() << " draw calls\n";
+
+    return 0;
+}
@@ -34,12 +34,22 @@
     #include <application-export.hpp>
 #endif
 
+#include <unordered_set>
+#include <string_view>
+#include <functional>
 #include <string>
 #include <memory>
 #include <vector>
+#include <atomic>
 #include <map>
 
+#include <SFML/System/Time.hpp>
+
 #include <Exceptions/ApplicationException.hpp>
+#include <FramePacer.hpp>
+#include <TimerQueue.hpp>
+#include <MPSCQueue.hpp>
+#include <Executor.hpp>
 #include <Textbox.hpp>
 #include <Routine.hpp>
 #include <Menu.hpp>
@@ -102,7 +112,7 @@ class Application
      * @throws MenuException More than one start menu declared.
      * @throws MenuException A menu with that ID already exists.
      */
-    ::std::shared_ptr<Menu> addMenu(const ::std::string&,
+    ::std::shared_ptr<Menu> addMenu(const ::std::string_view,
                                     const bool& = false);
 
     /**
@@ -112,7 +122,7 @@ class Application
      * 
      * @return ::std::shared_ptr<Menu>
      */
-    ::std::shared_ptr<Menu> getMenu(const ::std::string&);
+    ::std::shared_ptr<Menu> getMenu(const ::std::string_view);
 
     /**
      * @brief Retruns the active menu
@@ -139,6 +149,27 @@ class Application
      */
     ::std::shared_ptr<::sf::RenderWindow> getWindow();
 
+    /**
+     * @brief Returns the frame pacer
+     * 
+     * @details The pacer can be used at runtime to cap the frame rate, toggle
+     * vertical synchronization and inspect the frame-time budget.
+     * 
+     * @return ::std::shared_ptr<FramePacer>
+     */
+    ::std::shared_ptr<FramePacer> getFramePacer();
+
+    /**
+     * @brief Returns the executor of asynchronous tasks
+     * 
+     * @details Tasks marked as asynchronous (see Task#setAsync) run on this
+     * executor. Their completion callbacks are run on the UI thread at the
+     * beginning of every frame.
+     * 
+     * @return ::std::shared_ptr<Executor>
+     */
+    ::std::shared_ptr<Executor> getExecutor();
+
     /**
      * @brief Changes the active menu
      * 
@@ -146,7 +177,7 @@ class Application
      * 
      * @throw MenuException Invalid index provided
      */
-    void setActiveMenu(const ::std::string&);
+    void setActiveMenu(const ::std::string_view);
 
     /**
      * @brief Adds a new routine to the application
@@ -155,6 +186,61 @@ class Application
      */
     void addRoutine(const Routine&);
 
+    /**
+     * @brief Schedules a task to run after a delay
+     * 
+     * @details Timers are checked once per frame. In on-demand redraw mode
+     * the application wakes up for the next deadline, so timers stay
+     * accurate while the application is idle.
+     * 
+     * @param task The task to be run
+     * @param delay The delay, or the period of a repeating timer
+     * @param repeat Denotes whether the task runs periodically
+     * 
+     * @return uint32_t The ID of the timer
+     * 
+     * @throws ApplicationException Empty task provided
+     */
+    uint32_t addTimer(const ::std::shared_ptr<Task>&,
+                      const ::sf::Time&,
+                      const bool& = false);
+
+    /**
+     * @brief Cancels a timer
+     * 
+     * @param id The ID of the timer
+     */
+    void removeTimer(const uint32_t);
+
+    /**
+     * @brief Queues an action to be run on the UI thread
+     * 
+     * @details Can be called from any thread. Posted actions are run once per
+     * frame, after the window events have been handled and before the menu
+     * is drawn. This is the only safe way for other threads to update
+     * components, and the active menu is redrawn after the actions ran.
+     * 
+     * In on-demand redraw mode, an idle application waiting without a
+     * timeout only runs the actions after the next window event (see
+     * setIdleTimeout).
+     * 
+     * @param action The action to be run
+     */
+    void post(const ::std::function<void()>&);
+
+    /**
+     * @brief Queues an action to be run on the UI thread, keeping only the
+     * latest action per key
+     * 
+     * @details If several actions are posted with the same key before the
+     * UI thread gets to run them, only the last one is run. This is meant
+     * for updates that overwrite each other, such as setting a label's text.
+     * 
+     * @param key The coalescing key
+     * @param action The action to be run
+     */
+    void post(const uint64_t, const ::std::function<void()>&);
+
     /**
      * @brief Starts the application
      * 
@@ -171,18 +257,82 @@ class Application
      * @details Closes the application window.
      */
     void stop();
+
+    // ----- Redraw control -----
+
+    /**
+     * @brief Enables / Disables on-demand redrawing
+     * 
+     * @details By default the window is cleared and redrawn on every iteration
+     * of the main loop. In on-demand mode the application sleeps until an event
+     * arrives and only presents a new frame if the active menu has changed.
+     * 
+     * @param enabled Denotes whether frames are drawn only when needed
+     */
+    void setRedrawOnDemand(const bool&);
+
+    /**
+     * @brief Sets the longest time the application may wait for an event
+     * 
+     * @details Only used in on-demand mode. A zero timeout (the default) makes
+     * the application block until the next window event.
+     * 
+     * @param timeout The maximum waiting time
+     */
+    void setIdleTimeout(const ::sf::Time&);
+
+    /**
+     * @brief Returns the number of frames that have been presented
+     * 
+     * @return uint64_t
+     */
+    uint64_t getRenderedFrames() const;
+
+    /**
+     * @brief Returns the number of frames skipped since nothing changed
+     * 
+     * @return uint64_t
+     */
+    uint64_t getSkippedFrames() const;
  private:
     static ::std::shared_ptr<Application> _instance;
 
     ::std::shared_ptr<::sf::RenderWindow> _window;
+    ::std::shared_ptr<FramePacer> _pacer;
+    ::std::shared_ptr<Executor> _executor;
+    TimerQueue _timers;
+
+    // ----- Posted actions -----
+
+    struct PostedAction {
+        ::std::function<void()> action;
+        uint64_t key;
+        bool coalesce;
+    };
+
+    MPSCQueue<PostedAction> _posted;
+    ::std::vector<PostedAction> _postedBatch;
+    ::std::unordered_set<uint64_t> _postedKeys;
+    ::std::atomic<bool> _postPending;
 
-    ::std::map<::std::string, ::std::shared_ptr<Menu>> _menus;
+    // Transparent comparator: menus are looked up without allocating
+    ::std::map<::std::string, ::std::shared_ptr<Menu>, ::std::less<>> _menus;
     ::std::vector<Routine> _routines;
+
+    // Indexes of the routines, grouped by the event types they listen to
+    ::std::vector<uint32_t> _routinesByType[::sf::Event::Count];
+    ::std::vector<uint32_t> _genericRoutines;
     ::std::shared_ptr<Menu> _activeMenu;
 
     // ----- Control variables -----
 
     bool _startMenuSet;
+    bool _redrawOnDemand;
+
+    ::sf::Time _idleTimeout;
+
+    uint64_t _renderedFrames;
+    uint64_t _skippedFrames;
 
     /**
      * @brief Constructor
@@ -206,6 +356,60 @@ class Application
      * @param event The current window event
      */
     void handleEvents(const ::sf::Event&);
+
+    /**
+     * @brief Converts window coordinates to world coordinates
+     * 
+     * @details Events carry the position the mouse had when they were
+     * generated, which is used instead of the current mouse position.
+     * 
+     * @param x The horizontal position in pixels
+     * @param y The vertical position in pixels
+     * 
+     * @return Point
+     */
+    Point toWorld(const int, const int) const;
+
+    /**
+     * @brief Fires the routines that may match an event
+     * 
+     * @details Routines are evaluated in the order they were added.
+     * 
+     * @param event The current window event
+     */
+    void dispatchRoutines(const ::sf::Event&);
+
+    /**
+     * @brief Waits for the next window event
+     * 
+     * @param event Where the event is stored
+     * @param timeout The maximum waiting time, zero means no limit
+     * 
+     * @details A wait with a limit ends early when actions are posted.
+     * 
+     * @return true An event has been received
+     * @return false The timeout expired, or actions were posted
+     */
+    bool waitEvent(::sf::Event&, const ::sf::Time&);
+
+    /**
+     * @brief Computes how long the application may wait for an event
+     * 
+     * @return ::sf::Time
+     */
+    ::sf::Time getWaitTimeout() const;
+
+    /**
+     * @brief Runs the actions posted since the last frame
+     * 
+     */
+    void runPostedActions();
+
+    /**
+     * @brief Draws the active menu and presents the frame
+     * 
+     */
+    void render();
 };
 
 using ApplicationPtr = ::std::shared_ptr<Application>;
@@ -0,0 +1,237 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file BatchRenderer.hpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Definition of the BatchRenderer class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#pragma once
+
+// Including dependencies
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+    #include <application-export.hpp>
+#endif
+
+#include <unordered_map>
+#include <cstdint>
+#include <vector>
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include <ComponentRange.hpp>
+#include <SpatialGrid.hpp>
+#include <Geometry.hpp>
+
+
+namespace easyGUI {
+
+/**
+ * @brief Draws many components with few draw calls
+ * 
+ * @details The geometry of every component (see Component#buildGeometry) is
+ * merged into batches of vertices sharing the same texture, each drawn with
+ * a single call. A primitive may join an earlier batch of its texture only
+ * if it does not overlap anything drawn by the batches in between, so the
+ * result looks exactly as if the components were drawn one by one.
+ * 
+ * The geometry of a component is only rebuilt while the component is dirty.
+ * If its primitives keep their textures and vertex counts, and their new
+ * bounds keep the draw order, the batches are patched in place. Otherwise,
+ * all batches are rebuilt. Components that cannot be batched are drawn on
+ * their own, and nothing drawn after them is moved before them.
+ */
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+class APPLICATION_EXPORTS BatchRenderer
+#else
+class BatchRenderer
+#endif
+{
+ public:
+    /**
+     * @brief Destructor
+     * 
+     */
+    virtual ~BatchRenderer() = default;
+
+    /**
+     * @brief Constructor
+     * 
+     */
+    BatchRenderer() = default;
+
+    /**
+     * @brief Forces the geometry of all components to be rebuilt
+     * 
+     * @details Must be called whenever components are added or removed.
+     */
+    void invalidate();
+
+    /**
+     * @brief Brings the batches up to date
+     * 
+     * @param components The components, in draw order
+     */
+    void update(const ComponentRange&);
+
+    /**
+     * @brief Draws all batches
+     * 
+     * @param target The target to draw on
+     * @param states The states used for drawing
+     */
+    void draw(::sf::RenderTarget&, ::sf::RenderStates) const;
+
+    /**
+     * @brief Draws the batches that overlap an area
+     * 
+     * @param target The target to draw on
+     * @param states The states used for drawing
+     * @param area The visible area, in the coordinates of the components
+     */
+    void draw(::sf::RenderTarget&,
+              ::sf::RenderStates,
+              const ::sf::FloatRect&) const;
+
+    /**
+     * @brief Returns the number of draw calls issued by draw
+     * 
+     * @return size_t
+     */
+    size_t getBatchCount() const;
+ private:
+    struct Batch {
+        const ::sf::Texture* texture = nullptr;
+        const ::sf::Drawable* drawable = nullptr;
+
+        ::std::vector<::sf::Vertex> vertices;
+        ::sf::FloatRect bounds;
+    };
+
+    bool _valid = false;
+
+    ::std::vector<Geometry> _geometries;
+    ::std::vector<bool> _batched;
+    Geometry _scratch;
+
+    ::std::vector<Batch> _batches;
+    size_t _batchCount = 0;
+
+    ::std::unordered_map<const ::sf::Texture*, ::std::vector<uint32_t>>
+        _batchesByTexture;
+
+    // ----- Placement of primitives -----
+
+    SpatialGrid _grid;
+    ::std::vector<uint32_t> _itemBatch;
+    ::std::vector<uint32_t> _itemOffset;
+    ::std::vector<::sf::FloatRect> _itemBounds;
+    ::std::vector<uint32_t> _candidates;
+    uint32_t _barrier = 0;
+
+    // Per component: the first item placed, or the batch drawing it if it
+    // cannot be batched
+    ::std::vector<uint32_t> _placement;
+
+    /**
+     * @brief Distributes the geometry of all components in batches
+     * 
+     * @param components The components, in draw order
+     */
+    void rebuildBatches(const ComponentRange&);
+
+    /**
+     * @brief Places a primitive in the earliest batch that keeps the order
+     * 
+     * @param primitive The primitive to be placed
+     * @param geometry The geometry the primitive belongs to
+     */
+    void place(const Geometry::Primitive&, const Geometry&);
+
+    /**
+     * @brief Copies the new geometry of a component into its batches
+     * 
+     * @details Nothing is changed if the batches cannot be patched.
+     * 
+     * @param index The position of the component in draw order
+     * @param component The component
+     * @param batched Whether the new geometry can be batched
+     * @param geometry The new geometry of the component
+     * 
+     * @return true The batches were patched
+     * @return false The batches must be rebuilt
+     */
+    bool patch(const size_t,
+               const Component&,
+               const bool,
+               const Geometry&);
+
+    /**
+     * @brief Checks if an item may cover new bounds without being moved
+     * 
+     * @details The items it overlaps must still be drawn in the same order.
+     * The items of the same component are left to the caller.
+     * 
+     * @param item The item
+     * @param bounds The new bounds of the item
+     * @param first The first item of the component
+     * @param last One past the last item of the component
+     * 
+     * @return true The item may stay in its batch
+     * @return false otherwise
+     */
+    bool canMove(const uint32_t,
+                 const ::sf::FloatRect&,
+                 const uint32_t,
+                 const uint32_t);
+
+    /**
+     * @brief Appends an empty batch
+     * 
+     * @param texture The texture of the batch
+     * @param drawable The drawable of the batch, if any
+     * @param bounds The area covered by the batch
+     * 
+     * @return uint32_t The index of the batch
+     */
+    uint32_t addBatch(const ::sf::Texture*,
+                      const ::sf::Drawable*,
+                      const ::sf::FloatRect&);
+
+    /**
+     * @brief Draws a single batch
+     * 
+     * @param target The target to draw on
+     * @param states The states used for drawing
+     * @param batch The batch to be drawn
+     */
+    void drawBatch(::sf::RenderTarget&,
+                   const ::sf::RenderStates&,
+                   const Batch&) const;
+};
+
+}  // namespace easyGUI
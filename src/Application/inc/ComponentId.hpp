@@ -0,0 +1,141 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file ComponentId.hpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Definition of the ComponentId class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#pragma once
+
+// Including dependencies
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace easyGUI {
+
+/**
+ * @brief Hashed ID of a component
+ * 
+ * @details The ID is reduced to a 64-bit FNV-1a hash, which can be computed
+ * at compile time for literals (see operator""_id), so that looking up a
+ * component neither allocates nor compares strings. The ID also remembers
+ * the string it was built from, which menus use to detect hash collisions.
+ * That string must outlive the ComponentId.
+ */
+class ComponentId {
+ public:
+    /**
+     * @brief Constructor
+     * 
+     */
+    constexpr ComponentId() = default;
+
+    /**
+     * @brief Constructor
+     * 
+     * @param name The ID of the component
+     */
+    constexpr explicit ComponentId(const ::std::string_view name)
+        : _hash(hash(name)), _name(name) {}
+
+    /**
+     * @brief Returns the hash of the ID
+     * 
+     * @return uint64_t
+     */
+    constexpr uint64_t getHash() const {
+        return _hash;
+    }
+
+    /**
+     * @brief Returns the string the ID was built from
+     * 
+     * @return ::std::string_view
+     */
+    constexpr ::std::string_view getName() const {
+        return _name;
+    }
+
+    /**
+     * @brief Compares two IDs
+     * 
+     * @param other The ID to compare with
+     * 
+     * @return true The IDs have the same hash
+     * @return false otherwise
+     */
+    constexpr bool operator==(const ComponentId& other) const {
+        return _hash == other._hash;
+    }
+
+    /**
+     * @brief Compares two IDs
+     * 
+     * @param other The ID to compare with
+     * 
+     * @return true The IDs have different hashes
+     * @return false otherwise
+     */
+    constexpr bool operator!=(const ComponentId& other) const {
+        return _hash != other._hash;
+    }
+
+    /**
+     * @brief Computes the FNV-1a hash of a string
+     * 
+     * @param name The string to hash
+     * 
+     * @return uint64_t
+     */
+    static constexpr uint64_t hash(const ::std::string_view name) {
+        uint64_t result = 14695981039346656037ull;
+
+        for (const char character : name) {
+            result ^= static_cast<uint8_t>(character);
+            result *= 1099511628211ull;
+        }
+
+        return result;
+    }
+ private:
+    uint64_t _hash = hash(::std::string_view());
+    ::std::string_view _name;
+};
+
+/**
+ * @brief Builds a ComponentId at compile time
+ * 
+ * @param name The ID of the component
+ * @param length The length of the ID
+ * 
+ * @return ComponentId
+ */
+constexpr ComponentId operator""_id(const char* name, const size_t length) {
+    return ComponentId(::std::string_view(name, length));
+}
+
+}  // namespace easyGUI
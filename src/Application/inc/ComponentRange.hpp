@@ -0,0 +1,112 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file ComponentRange.hpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Definition of the ComponentRange class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#pragma once
+
+// Including dependencies
+#include <cstddef>
+#include <memory>
+
+#include <Component.hpp>
+
+
+namespace easyGUI {
+
+/**
+ * @brief Read-only view over a contiguous sequence of components
+ * 
+ * @details The range does not own the components nor the storage they live
+ * in, so iterating it neither allocates nor touches the reference counts of
+ * the components. A range is invalidated as soon as its owner (e.g. a menu)
+ * adds or removes components.
+ */
+class ComponentRange {
+ public:
+    using iterator = const ::std::shared_ptr<Component>*;
+
+    /**
+     * @brief Constructor
+     * 
+     */
+    ComponentRange() = default;
+
+    /**
+     * @brief Constructor
+     * 
+     * @param first Pointer to the first component
+     * @param last Pointer past the last component
+     */
+    ComponentRange(iterator first, iterator last)
+        : _first(first), _last(last) {}
+
+    /**
+     * @brief Returns an iterator to the first component
+     * 
+     * @return iterator
+     */
+    iterator begin() const { return _first; }
+
+    /**
+     * @brief Returns an iterator past the last component
+     * 
+     * @return iterator
+     */
+    iterator end() const { return _last; }
+
+    /**
+     * @brief Returns the number of components in the range
+     * 
+     * @return size_t
+     */
+    size_t size() const { return static_cast<size_t>(_last - _first); }
+
+    /**
+     * @brief Checks if the range holds no components
+     * 
+     * @return true The range is empty
+     * @return false otherwise
+     */
+    bool empty() const { return _first == _last; }
+
+    /**
+     * @brief Accesses a component of the range
+     * 
+     * @param index The position of the component
+     * 
+     * @return const ::std::shared_ptr<Component>&
+     */
+    const ::std::shared_ptr<Component>& operator[](const size_t index) const {
+        return _first[index];
+    }
+ private:
+    iterator _first = nullptr;
+    iterator _last = nullptr;
+};
+
+}  // namespace easyGUI
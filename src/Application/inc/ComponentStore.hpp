@@ -0,0 +1,357 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file ComponentStore.hpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Definition of the ComponentStore class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#pragma once
+
+// Including dependencies
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+    #include <application-export.hpp>
+#endif
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+
+#include <ComponentRange.hpp>
+#include <Component.hpp>
+
+
+namespace easyGUI {
+
+/**
+ * @brief Reference to a component held by a ComponentStore
+ * 
+ * @details A handle packs the index of a slot with the generation of that
+ * slot. Removing a component bumps the generation of its slot, so handles
+ * to removed components are recognized as stale even after the slot is
+ * reused. A default constructed handle refers to nothing.
+ */
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+class APPLICATION_EXPORTS ComponentHandle
+#else
+class ComponentHandle
+#endif
+{
+ public:
+    static constexpr uint32_t INDEX_BITS = 20;
+    static constexpr uint32_t GENERATION_BITS = 32 - INDEX_BITS;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_MASK = (1u << GENERATION_BITS) - 1;
+
+    /**
+     * @brief Constructor
+     * 
+     */
+    ComponentHandle() = default;
+
+    /**
+     * @brief Constructor
+     * 
+     * @param value The packed value of the handle
+     */
+    explicit ComponentHandle(const uint32_t value) : _value(value) {}
+
+    /**
+     * @brief Constructor
+     * 
+     * @param index The index of the slot
+     * @param generation The generation of the slot
+     */
+    ComponentHandle(const uint32_t index, const uint32_t generation)
+        : _value(((generation & GENERATION_MASK) << INDEX_BITS) |
+                 (index & INDEX_MASK)) {}
+
+    /**
+     * @brief Returns the index of the slot
+     * 
+     * @return uint32_t
+     */
+    uint32_t getIndex() const { return _value & INDEX_MASK; }
+
+    /**
+     * @brief Returns the generation of the slot
+     * 
+     * @return uint32_t
+     */
+    uint32_t getGeneration() const { return _value >> INDEX_BITS; }
+
+    /**
+     * @brief Returns the packed value of the handle
+     * 
+     * @return uint32_t
+     */
+    uint32_t getValue() const { return _value; }
+
+    /**
+     * @brief Checks if the handle refers to nothing
+     * 
+     * @return true The handle was default constructed
+     * @return false otherwise
+     */
+    bool isNull() const { return _value == 0; }
+
+    /**
+     * @brief Compares two handles
+     * 
+     * @param other The handle to compare with
+     * 
+     * @return true Both handles refer to the same component
+     * @return false otherwise
+     */
+    bool operator==(const ComponentHandle& other) const {
+        return _value == other._value;
+    }
+
+    /**
+     * @brief Compares two handles
+     * 
+     * @param other The handle to compare with
+     * 
+     * @return true The handles refer to different components
+     * @return false otherwise
+     */
+    bool operator!=(const ComponentHandle& other) const {
+        return _value != other._value;
+    }
+ private:
+    uint32_t _value = 0;
+};
+
+/**
+ * @brief Flags attached to every stored component
+ * 
+ */
+enum ComponentFlag : uint8_t {
+    HOVERED = 1 << 0,
+    DYNAMIC = 1 << 1,
+    HIDDEN = 1 << 2,
+    DISABLED = 1 << 3
+};
+
+/**
+ * @brief Dense storage of the components of a menu
+ * 
+ * @details Components, their bounds, layers and flags are kept in parallel
+ * arrays without gaps, in the order they were inserted. Within a layer,
+ * that order is also the order in which they are drawn. The components are
+ * addressed through generational handles, which stay valid while other
+ * components are inserted or removed.
+ */
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+class APPLICATION_EXPORTS ComponentStore
+#else
+class ComponentStore
+#endif
+{
+ public:
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    /**
+     * @brief Destructor
+     * 
+     */
+    virtual ~ComponentStore() = default;
+
+    /**
+     * @brief Constructor
+     * 
+     */
+    ComponentStore() = default;
+
+    /**
+     * @brief Adds a component to the store
+     * 
+     * @param component The component to be added
+     * @param bounds The bounds of the component
+     * 
+     * @throws MenuException The store is full
+     * @return ComponentHandle
+     */
+    ComponentHandle insert(const ::std::shared_ptr<Component>&,
+                           const ::sf::FloatRect&);
+
+    /**
+     * @brief Removes a component from the store
+     * 
+     * @details Components stored after the removed one keep their relative
+     * order.
+     * 
+     * @param handle The handle of the component
+     * 
+     * @return true The component was removed
+     * @return false The handle is stale
+     */
+    bool remove(const ComponentHandle&);
+
+    /**
+     * @brief Removes all components from the store
+     * 
+     * @details All handles given out so far become stale.
+     */
+    void clear();
+
+    /**
+     * @brief Checks if a handle refers to a stored component
+     * 
+     * @param handle The handle to check
+     * 
+     * @return true The component is still stored
+     * @return false The handle is null or stale
+     */
+    bool isValid(const ComponentHandle&) const;
+
+    /**
+     * @brief Returns the component a handle refers to
+     * 
+     * @param handle The handle of the component
+     * 
+     * @return ::std::shared_ptr<Component> nullptr if the handle is stale
+     */
+    ::std::shared_ptr<Component> get(const ComponentHandle&) const;
+
+    /**
+     * @brief Returns the position of a component in the dense arrays
+     * 
+     * @param handle The handle of the component
+     * 
+     * @return uint32_t INVALID_INDEX if the handle is stale
+     */
+    uint32_t getDenseIndex(const ComponentHandle&) const;
+
+    /**
+     * @brief Returns the number of stored components
+     * 
+     * @return size_t
+     */
+    size_t size() const;
+
+    /**
+     * @brief Returns a view over all components, in insertion order
+     * 
+     * @return ComponentRange
+     */
+    ComponentRange getComponents() const;
+
+    // ----- Dense access -----
+
+    /**
+     * @brief Returns a stored component
+     * 
+     * @param index The dense index of the component
+     * 
+     * @return const ::std::shared_ptr<Component>&
+     */
+    const ::std::shared_ptr<Component>& getComponent(const uint32_t) const;
+
+    /**
+     * @brief Returns the handle of a stored component
+     * 
+     * @param index The dense index of the component
+     * 
+     * @return ComponentHandle
+     */
+    ComponentHandle getHandle(const uint32_t) const;
+
+    /**
+     * @brief Returns the cached bounds of a component
+     * 
+     * @param index The dense index of the component
+     * 
+     * @return const ::sf::FloatRect&
+     */
+    const ::sf::FloatRect& getBounds(const uint32_t) const;
+
+    /**
+     * @brief Updates the cached bounds of a component
+     * 
+     * @param index The dense index of the component
+     * @param bounds The new bounds
+     */
+    void setBounds(const uint32_t, const ::sf::FloatRect&);
+
+    /**
+     * @brief Returns the layer (z-index) of a component
+     * 
+     * @param index The dense index of the component
+     * 
+     * @return int32_t
+     */
+    int32_t getLayer(const uint32_t) const;
+
+    /**
+     * @brief Moves a component to another layer
+     * 
+     * @param index The dense index of the component
+     * @param layer The new layer
+     */
+    void setLayer(const uint32_t, const int32_t);
+
+    /**
+     * @brief Returns the flags of a component
+     * 
+     * @param index The dense index of the component
+     * 
+     * @return uint8_t
+     */
+    uint8_t getFlags(const uint32_t) const;
+
+    /**
+     * @brief Sets or clears flags of a component
+     * 
+     * @param index The dense index of the component
+     * @param flags The flags to change
+     * @param value Whether the flags are set or cleared
+     */
+    void setFlags(const uint32_t, const uint8_t, const bool&);
+ private:
+    struct Slot {
+        uint32_t dense = INVALID_INDEX;
+        uint32_t generation = 1;
+    };
+
+    ::std::vector<Slot> _slots;
+    ::std::vector<uint32_t> _freeSlots;
+
+    ::std::vector<::std::shared_ptr<Component>> _components;
+    ::std::vector<::sf::FloatRect> _bounds;
+    ::std::vector<int32_t> _layers;
+    ::std::vector<uint8_t> _flags;
+    ::std::vector<ComponentHandle> _handles;
+
+    /**
+     * @brief Marks a slot as free and invalidates its handles
+     * 
+     * @param index The index of the slot
+     */
+    void release(const uint32_t);
+};
+
+}  // namespace easyGUI
@@ -0,0 +1,166 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file Executor.hpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Definition of the Executor class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#pragma once
+
+// Including dependencies
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+    #include <application-export.hpp>
+#endif
+
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <deque>
+
+#include <MPSCQueue.hpp>
+#include <Task.hpp>
+
+
+namespace easyGUI {
+
+/**
+ * @brief Runs asynchronous tasks on a pool of worker threads
+ * 
+ * @details Every worker owns a queue of tasks. Workers take the newest task
+ * from their own queue and, once it is empty, steal the oldest task from the
+ * queue of another worker. Tasks scheduled from outside the pool are spread
+ * over the workers in turn, while tasks scheduled by a worker stay on it.
+ * 
+ * Finished tasks are pushed into a lock-free completion queue, which the
+ * UI thread drains once per frame by calling Executor#drainCompletions.
+ * That is where Task#onComplete runs, so it may safely update components.
+ * 
+ * The worker threads are only started when the first task is scheduled.
+ */
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+class APPLICATION_EXPORTS Executor : public TaskScheduler
+#else
+class Executor : public TaskScheduler
+#endif
+{
+ public:
+    /**
+     * @brief Destructor
+     * 
+     * @details Waits for the running tasks and stops the workers. Tasks
+     * that have not started yet are discarded.
+     */
+    virtual ~Executor();
+
+    /**
+     * @brief Constructor
+     * 
+     * @param threads The number of workers, 0 picks one per spare CPU core
+     */
+    explicit Executor(const uint32_t = 0);
+
+    // Block other forms of construction
+
+    Executor(const Executor&) = delete;
+    Executor& operator= (const Executor&) = delete;
+
+    /**
+     * @brief Queues a task for execution on the pool
+     * 
+     * @param task The task to be executed
+     */
+    void schedule(const ::std::shared_ptr<Task>&) override;
+
+    /**
+     * @brief Calls Task#onComplete for every finished task
+     * 
+     * @details Must be called from the UI thread.
+     */
+    void drainCompletions();
+
+    /**
+     * @brief Checks if scheduled tasks have not been completed yet
+     * 
+     * @return true Some tasks are running or waiting for completion
+     * @return false otherwise
+     */
+    bool isBusy() const;
+
+    /**
+     * @brief Returns the number of worker threads
+     * 
+     * @return uint32_t
+     */
+    uint32_t getThreadCount() const;
+ private:
+    struct Worker {
+        ::std::mutex lock;
+        ::std::deque<::std::shared_ptr<Task>> tasks;
+        ::std::thread thread;
+    };
+
+    uint32_t _threadCount;
+    ::std::vector<::std::unique_ptr<Worker>> _workers;
+    ::std::once_flag _started;
+
+    ::std::atomic<bool> _running;
+    ::std::atomic<uint32_t> _nextWorker;
+    ::std::atomic<uint32_t> _queued;
+    ::std::atomic<uint32_t> _inFlight;
+
+    ::std::mutex _sleepLock;
+    ::std::condition_variable _wakeUp;
+
+    MPSCQueue<::std::shared_ptr<Task>> _completed;
+
+    /**
+     * @brief Creates the worker threads
+     * 
+     */
+    void start();
+
+    /**
+     * @brief The loop run by every worker
+     * 
+     * @param index The index of the worker
+     */
+    void work(const uint32_t);
+
+    /**
+     * @brief Takes a task from a worker's own queue or steals one
+     * 
+     * @param index The index of the worker
+     * @param task Where the task is stored
+     * 
+     * @return true A task has been found
+     * @return false All queues are empty
+     */
+    bool takeTask(const uint32_t, ::std::shared_ptr<Task>&);
+};
+
+}  // namespace easyGUI
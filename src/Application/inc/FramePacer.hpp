@@ -0,0 +1,265 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file FramePacer.hpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Definition of the FramePacer class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#pragma once
+
+// Including dependencies
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+    #include <application-export.hpp>
+#endif
+
+#include <memory>
+#include <vector>
+
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace easyGUI {
+
+/**
+ * @brief The phases of a frame that are timed separately
+ * 
+ */
+enum FramePhase {
+    EVENTS,
+    DRAW,
+    DISPLAY
+};
+
+/**
+ * @brief Denotes how the pacer waits for the next frame deadline
+ * 
+ * @details COARSE only sleeps, waking up early by the learned margin.
+ * PRECISE also spins on the remainder, which hits the deadline exactly
+ * but keeps a core busy.
+ */
+enum SleepMode {
+    COARSE,
+    PRECISE
+};
+
+/**
+ * @brief Controls the rate at which frames are presented
+ * 
+ * @details The pacer caps the frame rate by sleeping until the deadline of
+ * the next frame. Deadlines are advanced by a fixed period so that the average
+ * rate does not drift, and the amount by which the operating system oversleeps
+ * is learned over time and subtracted from every sleep. In PRECISE mode,
+ * which must be enabled explicitly, the remainder is spent yielding the
+ * thread until the deadline is reached.
+ * 
+ * The pacer also records how long each phase of a frame takes, so that the
+ * frame-time budget can be inspected at runtime.
+ */
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+class APPLICATION_EXPORTS FramePacer
+#else
+class FramePacer
+#endif
+{
+ public:
+    /**
+     * @brief Destructor
+     * 
+     */
+    virtual ~FramePacer() = default;
+
+    /**
+     * @brief Constructor
+     * 
+     * @param window The window whose frames are paced
+     */
+    explicit FramePacer(const ::std::shared_ptr<::sf::RenderWindow>&);
+
+    // ----- Configuration -----
+
+    /**
+     * @brief Sets the maximum number of frames per second
+     * 
+     * @param fps The frame rate cap, 0 disables the cap
+     */
+    void setTargetFPS(const uint32_t);
+
+    /**
+     * @brief Returns the frame rate cap
+     * 
+     * @return uint32_t
+     */
+    uint32_t getTargetFPS() const;
+
+    /**
+     * @brief Enables / Disables vertical synchronization
+     * 
+     * @param enabled Denotes whether presenting waits for the monitor refresh
+     */
+    void setVerticalSync(const bool&);
+
+    /**
+     * @brief Checks if vertical synchronization is enabled
+     * 
+     * @return bool
+     */
+    bool isVerticalSyncEnabled() const;
+
+    /**
+     * @brief Sets how the pacer waits for the frame deadline
+     * 
+     * @param mode The sleep mode, COARSE by default
+     */
+    void setSleepMode(const SleepMode&);
+
+    /**
+     * @brief Returns the sleep mode
+     * 
+     * @return SleepMode
+     */
+    SleepMode getSleepMode() const;
+
+    // ----- Frame control -----
+
+    /**
+     * @brief Marks the beginning of a frame
+     * 
+     */
+    void beginFrame();
+
+    /**
+     * @brief Marks the end of a frame phase
+     * 
+     * @details The phase duration is measured from the previous phase
+     * (or from the beginning of the frame).
+     * 
+     * @param phase The phase that has just finished
+     */
+    void endPhase(const FramePhase&);
+
+    /**
+     * @brief Marks the end of a frame
+     * 
+     * @details Sleeps until the deadline of the next frame if a frame rate
+     * cap is set.
+     */
+    void endFrame();
+
+    /**
+     * @brief Marks a pause between two frames
+     * 
+     * @details Called when the application sleeps until something happens,
+     * so that the pause is not recorded as a frame interval.
+     */
+    void pause();
+
+    // ----- Statistics -----
+
+    /**
+     * @brief Returns a percentile of the recent durations of a phase
+     * 
+     * @param phase The frame phase
+     * @param percentile A value in [0, 1], e.g. 0.99 for the p99
+     * 
+     * @return ::sf::Time
+     */
+    ::sf::Time getPhaseTime(const FramePhase&, const float& = 0.5f) const;
+
+    /**
+     * @brief Returns a percentile of the recent frame-to-frame intervals
+     * 
+     * @details Intervals spanning a pause (see pause) are not recorded.
+     * 
+     * @param percentile A value in [0, 1], e.g. 0.99 for the p99
+     * 
+     * @return ::sf::Time
+     */
+    ::sf::Time getFrameTime(const float& = 0.5f) const;
+
+    /**
+     * @brief Returns how early the pacer currently wakes before a deadline
+     * 
+     * @return ::sf::Time
+     */
+    ::sf::Time getSleepMargin() const;
+ private:
+    static const uint32_t SAMPLE_COUNT = 240;
+    static const uint32_t SERIES_COUNT = 4;
+    static const uint32_t FRAME_SERIES = 3;
+
+    ::std::shared_ptr<::sf::RenderWindow> _window;
+
+    uint32_t _targetFPS;
+    bool _verticalSync;
+    SleepMode _sleepMode;
+
+    ::sf::Clock _clock;
+    int64_t _deadline;
+    int64_t _phaseStart;
+    int64_t _lastFrameEnd;
+
+    // Learned oversleep of the operating system, in microseconds
+    double _oversleepMean;
+    double _oversleepDeviation;
+
+    ::std::vector<int64_t> _samples[SERIES_COUNT];
+    uint32_t _nextSample[SERIES_COUNT];
+
+    /**
+     * @brief Returns the current time in microseconds
+     * 
+     * @return int64_t
+     */
+    int64_t now() const;
+
+    /**
+     * @brief Sleeps until a point in time
+     * 
+     * @param deadline The wake-up time in microseconds
+     */
+    void sleepUntil(const int64_t);
+
+    /**
+     * @brief Stores a sample in one of the series
+     * 
+     * @param series The index of the series
+     * @param value The sample in microseconds
+     */
+    void record(const uint32_t, const int64_t);
+
+    /**
+     * @brief Computes a percentile of a series
+     * 
+     * @param series The index of the series
+     * @param percentile A value in [0, 1]
+     * 
+     * @return ::sf::Time
+     */
+    ::sf::Time percentileOf(const uint32_t, const float&) const;
+};
+
+}  // namespace easyGUI
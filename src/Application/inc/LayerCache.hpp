@@ -0,0 +1,144 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file LayerCache.hpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Definition of the LayerCache class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#pragma once
+
+// Including dependencies
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+    #include <application-export.hpp>
+#endif
+
+#include <memory>
+
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include <Component.hpp>
+
+
+namespace easyGUI {
+
+/**
+ * @brief Off-screen copy of the static components of a menu
+ * 
+ * @details The components are rendered once into a texture of the same
+ * size as the target, which is then drawn in a single call every frame.
+ * The cache only stays valid as long as the size and the view of the
+ * target do not change.
+ */
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+class APPLICATION_EXPORTS LayerCache
+#else
+class LayerCache
+#endif
+{
+ public:
+    /**
+     * @brief Destructor
+     * 
+     */
+    virtual ~LayerCache() = default;
+
+    /**
+     * @brief Constructor
+     * 
+     */
+    LayerCache() = default;
+
+    /**
+     * @brief Forces the cache to be rendered again
+     * 
+     */
+    void invalidate();
+
+    /**
+     * @brief Checks if the cache can be drawn on a target
+     * 
+     * @param target The target the cache is drawn on
+     * 
+     * @return true The cache is up to date for the target's size and view
+     * @return false otherwise
+     */
+    bool isValid(const ::sf::RenderTarget&) const;
+
+    /**
+     * @brief Clears the cache before rendering it again
+     * 
+     * @details Resizes the texture to the target if needed and copies the
+     * target's view.
+     * 
+     * @param target The target the cache is drawn on
+     * 
+     * @return true The cache is ready to be rendered
+     * @return false The texture could not be created for the target's size
+     */
+    bool begin(const ::sf::RenderTarget&);
+
+    /**
+     * @brief Renders a component into the cache
+     * 
+     * @param component The component to be rendered
+     * @param states The states the menu is drawn with
+     */
+    void add(const Component&, const ::sf::RenderStates&);
+
+    /**
+     * @brief Finishes rendering the cache
+     * 
+     */
+    void end();
+
+    /**
+     * @brief Draws the cache on a target
+     * 
+     * @param target The target the cache was rendered for
+     */
+    void draw(::sf::RenderTarget&) const;
+
+    /**
+     * @brief Releases the texture
+     * 
+     */
+    void release();
+ private:
+    // Created on first use, since a render texture owns its own context
+    ::std::unique_ptr<::sf::RenderTexture> _texture;
+    ::sf::Sprite _sprite;
+
+    ::sf::Vector2u _size;
+    ::sf::View _view;
+
+    bool _valid = false;
+    bool _failed = false;
+};
+
+}  // namespace easyGUI
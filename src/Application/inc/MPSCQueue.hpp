@@ -0,0 +1,138 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file MPSCQueue.hpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Definition of the MPSCQueue class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#pragma once
+
+// Including dependencies
+#include <atomic>
+#include <utility>
+
+
+namespace easyGUI {
+
+/**
+ * @brief Lock-free queue with many producers and a single consumer
+ * 
+ * @details Any thread may push into the queue without blocking, while only
+ * one thread (usually the UI thread) is allowed to pop. The queue is a linked
+ * list whose first node is a placeholder: producers atomically swap themselves
+ * in as the newest node, and the consumer follows the links from the oldest.
+ * 
+ * @tparam T The type of the stored elements
+ */
+template <typename T> class MPSCQueue {
+ public:
+    /**
+     * @brief Destructor
+     * 
+     */
+    virtual ~MPSCQueue() {
+        T discarded;
+
+        while (pop(discarded)) {}
+
+        delete _tail;
+    }
+
+    /**
+     * @brief Constructor
+     * 
+     */
+    MPSCQueue() {
+        Node* placeholder = new Node();
+
+        _head.store(placeholder);
+        _tail = placeholder;
+    }
+
+    // Block other forms of construction
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator= (const MPSCQueue&) = delete;
+
+    /**
+     * @brief Appends an element to the queue
+     * 
+     * @details Can be called from any thread.
+     * 
+     * @param value The element to be added
+     */
+    void push(T value) {
+        Node* node = new Node();
+        node->value = ::std::move(value);
+
+        Node* previous = _head.exchange(node, ::std::memory_order_acq_rel);
+        previous->next.store(node, ::std::memory_order_release);
+    }
+
+    /**
+     * @brief Removes the oldest element of the queue
+     * 
+     * @details Must only be called from the consumer thread.
+     * 
+     * @param value Where the element is stored
+     * 
+     * @return true An element has been removed
+     * @return false The queue is empty
+     */
+    bool pop(T& value) {
+        Node* next = _tail->next.load(::std::memory_order_acquire);
+
+        if (next == nullptr)
+            return false;
+
+        value = ::std::move(next->value);
+
+        delete _tail;
+        _tail = next;
+
+        return true;
+    }
+
+    /**
+     * @brief Checks if the queue is empty
+     * 
+     * @details Must only be called from the consumer thread.
+     * 
+     * @return bool
+     */
+    bool empty() const {
+        return _tail->next.load(::std::memory_order_acquire) == nullptr;
+    }
+ private:
+    struct Node {
+        ::std::atomic<Node*> next{nullptr};
+        T value;
+    };
+
+    ::std::atomic<Node*> _head;
+    Node* _tail;
+};
+
+}  // namespace easyGUI
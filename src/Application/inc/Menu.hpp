@@ -34,13 +34,22 @@
     #include <application-export.hpp>
 #endif
 
+#include <unordered_map>
+#include <string_view>
 #include <string>
 #include <vector>
 #include <memory>
-#include <map>
 
 #include <Exceptions/AssetException.hpp>
 #include <Exceptions/MenuException.hpp>
+#include <ComponentStore.hpp>
+#include <ComponentId.hpp>
+#include <StaticDispatcher.hpp>
+#include <BatchRenderer.hpp>
+#include <LayerCache.hpp>
+#include <ComponentRange.hpp>
+#include <SpatialGrid.hpp>
+#include <AlignmentTool.hpp>
 #include <Component.hpp>
 
 
@@ -54,11 +63,22 @@ using WindowPtr = ::std::shared_ptr<::sf::RenderWindow>;
  * @details A menu groups different application components under the same container
  * and usually corresponds to a specific application screen. The menu also provides
  * a method for the components to react to events.
+ * 
+ * The menu keeps a spatial index over the bounds of its components, so that
+ * finding the components under the cursor does not require testing all of
+ * them. The index is kept up to date as components notify the menu of their
+ * changes.
+ * 
+ * Components are drawn by layer (see setLayer), and within a layer in the
+ * order they were added, so later components appear on top of earlier ones.
+ * Components outside the view of the target are not drawn at all (see
+ * setCulling), and hidden ones are neither drawn nor hit.
  */
 #if defined(_WIN32) && BUILD_SHARED_LIBRARIES
-class APPLICATION_EXPORTS Menu : public ::sf::Drawable
+class APPLICATION_EXPORTS Menu : public ::sf::Drawable,
+                                 public ComponentObserver
 #else
-class Menu : public ::sf::Drawable
+class Menu : public ::sf::Drawable, public ComponentObserver
 #endif
 {
  public:
@@ -66,13 +86,14 @@ class Menu : public ::sf::Drawable
      * @brief Destructor
      * 
      */
-    virtual ~Menu() = default;
+    virtual ~Menu();
 
     /**
      * @brief Constructor
      * 
+     * @details Creates the binding scope of the menu.
      */
-    Menu() = default;
+    Menu();
 
     /**
      * @brief Adds a new component to the menu
@@ -81,9 +102,23 @@ class Menu : public ::sf::Drawable
      * @param ID A unique ID for the component
      * 
      * @throws MenuException A component with that ID already exists
+     * @throws MenuException The hash of the ID collides with another ID
+     * @return ComponentHandle A handle to the added component
      */
-    void addComponent(const ::std::shared_ptr<Component>&,
-                      const ::std::string&);
+    ComponentHandle addComponent(const ::std::shared_ptr<Component>&,
+                                 const ::std::string_view);
+
+    /**
+     * @brief Removes a component from the menu
+     * 
+     * @details Handles to the removed component become stale.
+     * 
+     * @param ID The ID of the component
+     * 
+     * @return true The component was removed
+     * @return false No component has that ID
+     */
+    bool removeComponent(const ::std::string_view);
 
     /**
      * @brief Set the Component's container
@@ -98,24 +133,509 @@ class Menu : public ::sf::Drawable
      * @param ID The ID of the component
      * @return ::std::shared_ptr<Component>
      */
-    ::std::shared_ptr<Component> getComponent(const ::std::string&);
+    ::std::shared_ptr<Component> getComponent(const ::std::string_view);
+
+    /**
+     * @brief Retrieves a specific component
+     * 
+     * @details Prefer IDs built at compile time (e.g. "ok"_id), which
+     * reduce the lookup to a single hash probe.
+     * 
+     * @param ID The hashed ID of the component
+     * @return ::std::shared_ptr<Component>
+     */
+    ::std::shared_ptr<Component> getComponent(const ComponentId&);
+
+    /**
+     * @brief Retrieves a specific component
+     * 
+     * @param handle The handle returned when the component was added
+     * @return ::std::shared_ptr<Component> nullptr if the handle is stale
+     */
+    ::std::shared_ptr<Component> getComponent(const ComponentHandle&);
+
+    /**
+     * @brief Returns the handle of a component
+     * 
+     * @param ID The ID of the component
+     * @return ComponentHandle A null handle if no component has that ID
+     */
+    ComponentHandle getHandle(const ::std::string_view) const;
+
+    /**
+     * @brief Returns the handle of a component
+     * 
+     * @param ID The hashed ID of the component
+     * @return ComponentHandle A null handle if no component has that ID
+     */
+    ComponentHandle getHandle(const ComponentId&) const;
 
     /**
      * @brief Returns a vector with all components
      * 
      * @return ::std::vector<Component*> 
+     * @deprecated Copies every component. Use getComponents instead.
      */
     ::std::vector<::std::shared_ptr<Component>> getAllComponents();
 
+    /**
+     * @brief Returns a view over all components
+     * 
+     * @details The components are listed in the order they were added,
+     * hidden ones included. The view does not allocate and stays valid
+     * until the menu is modified.
+     * 
+     * @return ComponentRange
+     */
+    ComponentRange getComponents() const;
+
+    /**
+     * @brief Returns the components found under a point
+     * 
+     * @details The components are ordered from the topmost (drawn last)
+     * to the bottommost. Hidden and disabled components are left out. The
+     * returned view is reused by the next call.
+     * 
+     * @param point The point in world coordinates
+     * 
+     * @return ComponentRange
+     */
+    ComponentRange getComponentsAt(const Point&);
+
+    /**
+     * @brief Updates the set of hovered components
+     * 
+     * @details Fires onHoverEnter for the components the point just entered
+     * and onHoverLeave for the ones it just left. Moving inside the same
+     * components fires nothing.
+     * 
+     * @param point The position of the mouse in world coordinates
+     */
+    void updateHover(const Point&);
+
+    /**
+     * @brief Fires onHoverLeave for all hovered components
+     * 
+     * @details Used when the mouse leaves the window or the menu is hidden.
+     */
+    void clearHover();
+
+    /**
+     * @brief Updates the spatial index of a component
+     * 
+     * @param component The component that changed
+     */
+    void onComponentUpdate(Component&) override;
+
     /**
      * @brief Clears the menu of all content.
      * 
+     * @details The bindings created while adding the elements of the menu
+     * (see AddElement) are dropped along with them. The bindings built-in
+     * components create for their own parts (e.g. the label of a button)
+     * are kept, so components still held elsewhere keep working. Those are
+     * released along with the components.
      */
     void clear();
+
+    /**
+     * @brief Returns the binding scope of the menu
+     * 
+     * @details Bindings created in this scope are released when the menu
+     * is cleared or destroyed (see AlignmentTool#ScopeGuard).
+     * 
+     * @return BindingScope
+     */
+    BindingScope getBindingScope() const;
+
+    /**
+     * @brief Toggles drawing without virtual calls
+     * 
+     * @details When enabled, the built-in components are grouped by type
+     * and drawn by loops that call their draw methods directly (see
+     * StaticDispatcher). Other components still go through virtual calls.
+     * Disabled by default.
+     * 
+     * @param enabled Whether static dispatch is used
+     */
+    void setStaticDispatch(const bool&);
+
+    /**
+     * @brief Checks if the menu draws without virtual calls
+     * 
+     * @return true Static dispatch is enabled
+     * @return false otherwise
+     */
+    bool isStaticDispatch() const;
+
+    /**
+     * @brief Toggles batching of draw calls
+     * 
+     * @details When enabled, the menu merges the geometry of its components
+     * into as few draw calls as possible (see BatchRenderer), rebuilding
+     * only the components that are dirty. Takes precedence over static
+     * dispatch. Disabled by default.
+     * 
+     * @param enabled Whether draw calls are batched
+     */
+    void setBatching(const bool&);
+
+    /**
+     * @brief Checks if the menu batches its draw calls
+     * 
+     * @return true Batching is enabled
+     * @return false otherwise
+     */
+    bool isBatching() const;
+
+    /**
+     * @brief Returns the number of draw calls of the last batched frame
+     * 
+     * @return size_t
+     */
+    size_t getBatchCount() const;
+
+    /**
+     * @brief Toggles caching of the static components
+     * 
+     * @details When enabled, the components that are neither dynamic nor
+     * dirty are rendered once into an off-screen texture, which is drawn
+     * every frame instead of them. Dynamic and dirty components are drawn
+     * on top of it, one by one. The cache is rendered again whenever one of
+     * its components changes, or the size or view of the target changes.
+     * Takes precedence over batching and static dispatch. Disabled by
+     * default.
+     * 
+     * @param enabled Whether the static components are cached
+     */
+    void setCaching(const bool&);
+
+    /**
+     * @brief Checks if the menu caches its static components
+     * 
+     * @return true Caching is enabled
+     * @return false otherwise
+     */
+    bool isCaching() const;
+
+    /**
+     * @brief Flags a component as changing often
+     * 
+     * @details Dynamic components are never cached (see setCaching), so
+     * their changes do not cause the cache to be rendered again. They are
+     * always drawn above the cached components.
+     * 
+     * @param handle The handle of the component
+     * @param dynamic Whether the component is dynamic
+     * 
+     * @return true The flag was set
+     * @return false The handle is stale
+     */
+    bool setDynamic(const ComponentHandle&, const bool&);
+
+    /**
+     * @brief Flags a component as changing often
+     * 
+     * @param ID The ID of the component
+     * @param dynamic Whether the component is dynamic
+     * 
+     * @return true The flag was set
+     * @return false No component has that ID
+     */
+    bool setDynamic(const ::std::string_view, const bool&);
+
+    /**
+     * @brief Toggles culling of the components outside the view
+     * 
+     * @details When enabled, only the components whose bounds intersect the
+     * area shown by the view of the target are drawn. They are found
+     * through the spatial index, so drawing costs depend on the number of
+     * visible components rather than on the size of the menu. Applies to
+     * batches and to the components drawn above the cache as well, but not
+     * to static dispatch. Enabled by default.
+     * 
+     * @param enabled Whether components outside the view are skipped
+     */
+    void setCulling(const bool&);
+
+    /**
+     * @brief Checks if the menu skips the components outside the view
+     * 
+     * @return true Culling is enabled
+     * @return false otherwise
+     */
+    bool isCulling() const;
+
+    // ----- Layers and visibility -----
+
+    /**
+     * @brief Moves a component to another layer
+     * 
+     * @details Layers are drawn from the lowest to the highest, so
+     * components in higher layers appear on top. All components start in
+     * layer 0.
+     * 
+     * @param handle The handle of the component
+     * @param layer The z-index of the layer
+     * 
+     * @return true The component was moved
+     * @return false The handle is stale
+     */
+    bool setLayer(const ComponentHandle&, const int32_t);
+
+    /**
+     * @brief Returns the layer of a component
+     * 
+     * @param handle The handle of the component
+     * 
+     * @return int32_t 0 if the handle is stale
+     */
+    int32_t getLayer(const ComponentHandle&) const;
+
+    /**
+     * @brief Shows or hides a component
+     * 
+     * @details Hidden components stay in the menu but are neither drawn
+     * nor returned by hit testing. Hiding a hovered component fires its
+     * onHoverLeave.
+     * 
+     * @param handle The handle of the component
+     * @param visible Whether the component is shown
+     * 
+     * @return true The visibility was set
+     * @return false The handle is stale
+     */
+    bool setVisible(const ComponentHandle&, const bool&);
+
+    /**
+     * @brief Checks if a component is shown
+     * 
+     * @param handle The handle of the component
+     * 
+     * @return true The component is shown
+     * @return false The component is hidden or the handle is stale
+     */
+    bool isVisible(const ComponentHandle&) const;
+
+    /**
+     * @brief Enables or disables a component
+     * 
+     * @details Disabled components are still drawn, but are not returned by
+     * hit testing, so they receive no clicks and no hover events.
+     * 
+     * @param handle The handle of the component
+     * @param enabled Whether the component reacts to the mouse
+     * 
+     * @return true The state was set
+     * @return false The handle is stale
+     */
+    bool setEnabled(const ComponentHandle&, const bool&);
+
+    /**
+     * @brief Checks if a component reacts to the mouse
+     * 
+     * @param handle The handle of the component
+     * 
+     * @return true The component is enabled
+     * @return false The component is disabled or the handle is stale
+     */
+    bool isEnabled(const ComponentHandle&) const;
+
+    // ----- Redraw tracking -----
+
+    /**
+     * @brief Forces the menu to be redrawn on the next frame
+     * 
+     */
+    void markDirty();
+
+    /**
+     * @brief Checks if the menu or any of its components changed
+     * 
+     * @details Components report their changes through markDirty, so this
+     * check does not depend on the number of components.
+     * 
+     * @return true The menu needs to be redrawn
+     * @return false otherwise
+     */
+    bool isDirty() const;
+
+    /**
+     * @brief Marks the menu and all its components as up to date
+     * 
+     */
+    void clearDirty();
  private:
-    ::std::map<::std::string, ::std::shared_ptr<Component>> _components;
+    struct IndexEntry {
+        ComponentHandle handle;
+        ::std::string name;
+    };
+
+    ::std::unordered_map<uint64_t, IndexEntry> _index;
     ::std::shared_ptr<::sf::RenderWindow> _container;
 
+    bool _dirty = true;
+
+    ComponentStore _store;
+
+    BindingScope _bindingScope = GLOBAL_SCOPE;
+
+    bool _staticDispatch = false;
+    mutable StaticDispatcher _dispatcher;
+    mutable bool _dispatchValid = false;
+
+    bool _batching = false;
+    mutable BatchRenderer _renderer;
+
+    bool _caching = false;
+    mutable LayerCache _cache;
+    mutable ::std::vector<bool> _cached;
+    mutable ::std::vector<uint32_t> _live;
+
+    bool _culling = true;
+    mutable ::std::vector<uint32_t> _visible;
+
+    // ----- Draw order -----
+
+    // Dense indices sorted by layer, then by insertion order
+    ::std::vector<uint32_t> _drawOrder;
+    ::std::vector<uint32_t> _drawRank;
+
+    // The visible components, in draw order
+    mutable ::std::vector<::std::shared_ptr<Component>> _drawList;
+    mutable bool _drawListValid = false;
+
+    ::std::unordered_map<const Component*, ComponentHandle> _handleOf;
+
+    // ----- Hit testing -----
+
+    SpatialGrid _grid;
+
+    ::std::vector<uint32_t> _candidates;
+    ::std::vector<::std::shared_ptr<Component>> _hits;
+    ::std::vector<::std::shared_ptr<Component>> _hovered;
+
+    /**
+     * @brief Looks up the entry of an ID
+     * 
+     * @details Debug builds also check that the entry was added under the
+     * same ID, reporting hash collisions.
+     * 
+     * @param ID The hashed ID of the component
+     * 
+     * @return const IndexEntry* nullptr if no component has that ID
+     */
+    const IndexEntry* find(const ComponentId&) const;
+
+    /**
+     * @brief Returns the position of a component in the store
+     * 
+     * @param component A component of the menu
+     * 
+     * @return uint32_t
+     */
+    uint32_t getDenseIndex(const Component&) const;
+
+    /**
+     * @brief Sets the hovered flag of a component
+     * 
+     * @param component A component of the menu
+     * @param hovered The new value of the flag
+     */
+    void setHovered(const Component&, const bool&);
+
+    /**
+     * @brief Checks the hovered flag of a component
+     * 
+     * @param component A component of the menu
+     * 
+     * @return true The component is flagged as hovered
+     * @return false otherwise
+     */
+    bool isHovered(const Component&) const;
+
+    /**
+     * @brief Fires onHoverLeave if a component is hovered
+     * 
+     * @param dense The dense index of the component
+     */
+    void stopHover(const uint32_t);
+
+    /**
+     * @brief Checks if a component is drawn before another
+     * 
+     * @param first The dense index of the first component
+     * @param second The dense index of the second component
+     * 
+     * @return true The first component is drawn before the second
+     * @return false otherwise
+     */
+    bool precedes(const uint32_t, const uint32_t) const;
+
+    /**
+     * @brief Inserts a component in the draw order
+     * 
+     * @param dense The dense index of the component
+     * 
+     * @return size_t The position of the component in the draw order
+     */
+    size_t insertDrawOrder(const uint32_t);
+
+    /**
+     * @brief Removes a component from the draw order
+     * 
+     * @details Must be called right before the component is removed from
+     * the store, whose dense indices are shifted accordingly.
+     * 
+     * @param dense The dense index of the component
+     */
+    void eraseDrawOrder(const uint32_t);
+
+    /**
+     * @brief Updates the draw ranks from a position of the draw order on
+     * 
+     * @param first The first position that changed
+     */
+    void updateDrawRanks(const size_t);
+
+    /**
+     * @brief Forces everything derived from the draw order to be rebuilt
+     * 
+     */
+    void invalidateDrawList();
+
+    /**
+     * @brief Returns the visible components, in draw order
+     * 
+     * @return ComponentRange
+     */
+    ComponentRange getDrawList() const;
+
+    /**
+     * @brief Draws the cache and the components that are not cached
+     * 
+     * @details Renders the cache again first if needed.
+     * 
+     * @param target The target to draw on
+     * @param states The states the menu is drawn with
+     * 
+     * @return true The menu was drawn
+     * @return false The cache could not be created
+     */
+    bool drawCached(::sf::RenderTarget&, const ::sf::RenderStates&) const;
+
+    /**
+     * @brief Finds the components that intersect an area
+     * 
+     * @details The result is reused by the next call.
+     * 
+     * @param area The area, in world coordinates
+     * 
+     * @return const ::std::vector<uint32_t>& The dense indices of the
+     * components, in draw order
+     */
+    const ::std::vector<uint32_t>& findVisible(const ::sf::FloatRect&) const;
+
     virtual void draw(::sf::RenderTarget&, ::sf::RenderStates) const;
 };
 
@@ -137,6 +657,9 @@ void AddElement(const MenuPtr& targetMenu,
                 const ::std::string& id,
                 Args... constructorArgs) {
     try {
+        // Bindings created by the component belong to the menu
+        AlignmentTool::ScopeGuard guard(targetMenu->getBindingScope());
+
         ::std::shared_ptr<Class> ptr =
             ::std::make_shared<Class>(constructorArgs...);
         targetMenu->addComponent(ptr, id);
@@ -35,6 +35,7 @@
 #endif
 
 #include <memory>
+#include <vector>
 
 #include <SFML/Window/Event.hpp>
 
@@ -55,6 +56,10 @@ namespace easyGUI {
  * routine may also fire if it is configured to fire whenever the mouse is pressed, regardless
  * of the mouse position.
  * 
+ * A routine may declare the event types it listens to. The application then
+ * only evaluates its trigger for those events. Routines without a declaration
+ * are evaluated for every event.
+ * 
  */
 #if defined(_WIN32) && BUILD_SHARED_LIBRARIES
 class APPLICATION_EXPORTS Routine
@@ -87,6 +92,17 @@ class Routine
      */
     Routine(bool (*)(const ::sf::Event&), const ::std::shared_ptr<Task>&);
 
+    /**
+     * @brief Constructor
+     * 
+     * @param trigger The trigger of the routine
+     * @param response The response of the routine
+     * @param eventTypes The only event types that can trigger the routine
+     */
+    Routine(bool (*)(const ::sf::Event&),
+            const ::std::shared_ptr<Task>&,
+            const ::std::vector<::sf::Event::EventType>&);
+
     /**
      * @brief Call operator
      * 
@@ -103,9 +119,19 @@ class Routine
      * @param active Denotes whether the routine should be active
      */
     void setActive(const bool& active);
+
+    /**
+     * @brief Returns the event types the routine listens to
+     * 
+     * @details An empty list means the routine listens to all events.
+     * 
+     * @return const ::std::vector<::sf::Event::EventType>&
+     */
+    const ::std::vector<::sf::Event::EventType>& getEventTypes() const;
  private:
     bool (*_trigger)(const ::sf::Event& action);
     ::std::shared_ptr<Task> _action;
+    ::std::vector<::sf::Event::EventType> _eventTypes;
 
     bool _isActive;
 
@@ -0,0 +1,192 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file SpatialGrid.hpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Definition of the SpatialGrid class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#pragma once
+
+// Including dependencies
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+    #include <application-export.hpp>
+#endif
+
+#include <unordered_map>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+
+#include <Point.hpp>
+
+
+namespace easyGUI {
+
+/**
+ * @brief Uniform grid used to find the elements under a point
+ * 
+ * @details The plane is split in square cells and every element is stored
+ * in each cell its bounds overlap. A point query then only has to look at
+ * the elements of a single cell. Elements that would span too many cells
+ * are kept in a separate list that every query checks.
+ * 
+ * Elements are identified by an index chosen by the owner of the grid.
+ */
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+class APPLICATION_EXPORTS SpatialGrid
+#else
+class SpatialGrid
+#endif
+{
+ public:
+    /**
+     * @brief Destructor
+     * 
+     */
+    virtual ~SpatialGrid() = default;
+
+    /**
+     * @brief Constructor
+     * 
+     * @param cellSize The length of a cell's side
+     */
+    explicit SpatialGrid(const float& = 64.0f);
+
+    /**
+     * @brief Adds an element to the grid
+     * 
+     * @param index The index of the element
+     * @param bounds The bounds of the element
+     */
+    void insert(const uint32_t, const ::sf::FloatRect&);
+
+    /**
+     * @brief Removes an element from the grid
+     * 
+     * @param index The index of the element
+     * @param bounds The bounds the element was inserted with
+     */
+    void remove(const uint32_t, const ::sf::FloatRect&);
+
+    /**
+     * @brief Moves an element to new bounds
+     * 
+     * @param index The index of the element
+     * @param oldBounds The bounds the element was inserted with
+     * @param newBounds The new bounds of the element
+     */
+    void update(const uint32_t,
+                const ::sf::FloatRect&,
+                const ::sf::FloatRect&);
+
+    /**
+     * @brief Collects the elements that may contain a point
+     * 
+     * @details The candidates are appended to the output vector. They still
+     * need to be tested against their exact bounds.
+     * 
+     * @param point The queried point
+     * @param result Where the candidates are stored
+     */
+    void query(const Point&, ::std::vector<uint32_t>&) const;
+
+    /**
+     * @brief Collects the elements that may overlap an area
+     * 
+     * @details The candidates are appended to the output vector and may
+     * appear more than once. They still need to be tested against their
+     * exact bounds. Only the populated cells inside the area are visited,
+     * so querying a large area costs no more than the grid's content.
+     * 
+     * @param bounds The queried area
+     * @param result Where the candidates are stored
+     */
+    void query(const ::sf::FloatRect&, ::std::vector<uint32_t>&) const;
+
+    /**
+     * @brief Removes all elements from the grid
+     * 
+     */
+    void clear();
+ private:
+    struct CellRange {
+        int32_t minX, minY;
+        int32_t maxX, maxY;
+
+        bool isOversized() const noexcept;
+    };
+
+    float _cellSize;
+
+    ::std::unordered_map<int64_t, ::std::vector<uint32_t>> _cells;
+    ::std::vector<uint32_t> _oversized;
+
+    // Covers every populated cell, grows until the grid is emptied
+    CellRange _extent;
+
+    /**
+     * @brief Computes the cells covered by some bounds
+     * 
+     * @param bounds The bounds of an element
+     * 
+     * @return CellRange
+     */
+    CellRange getRange(const ::sf::FloatRect&) const noexcept;
+
+    /**
+     * @brief Computes the cell coordinate of a position
+     * 
+     * @param position A coordinate on one of the axes
+     * 
+     * @return int32_t
+     */
+    int32_t toCell(const float&) const noexcept;
+
+    /**
+     * @brief Computes the key of a cell
+     * 
+     * @param x The column of the cell
+     * @param y The row of the cell
+     * 
+     * @return int64_t
+     */
+    static int64_t getKey(const int32_t, const int32_t) noexcept;
+
+    /**
+     * @brief Marks the populated extent as empty
+     * 
+     */
+    void resetExtent() noexcept;
+
+    /**
+     * @brief Removes an index from a list
+     * 
+     * @param list The list of indexes
+     * @param index The index to be removed
+     */
+    static void erase(::std::vector<uint32_t>&, const uint32_t);
+};
+
+}  // namespace easyGUI
@@ -0,0 +1,148 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file StaticDispatcher.hpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Definition of the StaticDispatcher class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#pragma once
+
+// Including dependencies
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+    #include <application-export.hpp>
+#endif
+
+#include <cstdint>
+#include <vector>
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+
+#include <ComponentRange.hpp>
+#include <PasswordBox.hpp>
+#include <Separator.hpp>
+#include <CheckBox.hpp>
+#include <Textbox.hpp>
+#include <Button.hpp>
+#include <Label.hpp>
+#include <Image.hpp>
+
+
+namespace easyGUI {
+
+/**
+ * @brief Draws components without going through virtual calls
+ * 
+ * @details The built-in components are grouped by their concrete type in
+ * separate arrays, and each array is drawn by a loop that calls the draw
+ * method of that type directly. Components of other types, including user
+ * subclasses of the built-in ones, are drawn through the usual virtual
+ * call (see Component#isExactly).
+ * 
+ * The draw order is preserved: consecutive components of the same type form
+ * a run, and the runs are drawn one after the other.
+ */
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+class APPLICATION_EXPORTS StaticDispatcher
+#else
+class StaticDispatcher
+#endif
+{
+ public:
+    /**
+     * @brief Destructor
+     * 
+     */
+    virtual ~StaticDispatcher() = default;
+
+    /**
+     * @brief Constructor
+     * 
+     */
+    StaticDispatcher() = default;
+
+    /**
+     * @brief Groups a sequence of components by type
+     * 
+     * @param components The components, in draw order
+     */
+    void rebuild(const ComponentRange&);
+
+    /**
+     * @brief Removes all components from the dispatcher
+     * 
+     */
+    void clear();
+
+    /**
+     * @brief Draws all components, in draw order
+     * 
+     * @param target The target to draw on
+     * @param states The states used for drawing
+     */
+    void draw(::sf::RenderTarget&, ::sf::RenderStates) const;
+ private:
+    struct Run {
+        TypeTag tag;
+        uint32_t first;
+        uint32_t count;
+    };
+
+    ::std::vector<Run> _runs;
+
+    ::std::vector<const Button*> _buttons;
+    ::std::vector<const Label*> _labels;
+    ::std::vector<const TextBox*> _textBoxes;
+    ::std::vector<const Image*> _images;
+    ::std::vector<const CheckBox*> _checkBoxes;
+    ::std::vector<const Separator*> _separators;
+    ::std::vector<const Component*> _others;
+
+    /**
+     * @brief Appends a component to the array of its type
+     * 
+     * @param group The array of the component's type
+     * @param component The component to be appended
+     * @param tag The tag of the run the component belongs to
+     */
+    template <class T>
+    void append(::std::vector<const T*>&, const Component*, const TypeTag);
+
+    /**
+     * @brief Draws a run of components of the same type
+     * 
+     * @param group The array of the run's type
+     * @param run The run to be drawn
+     * @param target The target to draw on
+     * @param states The states used for drawing
+     */
+    template <class T>
+    static void drawRun(const ::std::vector<const T*>&,
+                        const Run&,
+                        ::sf::RenderTarget&,
+                        const ::sf::RenderStates&);
+};
+
+}  // namespace easyGUI
@@ -0,0 +1,155 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file TimerQueue.hpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Definition of the TimerQueue class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#pragma once
+
+// Including dependencies
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+    #include <application-export.hpp>
+#endif
+
+#include <unordered_set>
+#include <memory>
+#include <vector>
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <Task.hpp>
+
+
+namespace easyGUI {
+
+/**
+ * @brief Schedules tasks to run after a delay or periodically
+ * 
+ * @details Timers are kept in a binary min-heap ordered by deadline, so the
+ * next deadline is always known in constant time. Removed timers are only
+ * marked as such and are discarded once they reach the top of the heap.
+ * 
+ * Repeating timers are rescheduled relative to their previous deadline, so
+ * that they do not drift. If the application falls behind, missed ticks are
+ * skipped instead of being run in a burst.
+ */
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+class APPLICATION_EXPORTS TimerQueue
+#else
+class TimerQueue
+#endif
+{
+ public:
+    /**
+     * @brief Destructor
+     * 
+     */
+    virtual ~TimerQueue() = default;
+
+    /**
+     * @brief Constructor
+     * 
+     */
+    TimerQueue() = default;
+
+    /**
+     * @brief Schedules a task
+     * 
+     * @param task The task to be run
+     * @param delay The delay (or period) of the timer
+     * @param repeat Denotes whether the task runs periodically
+     * 
+     * @return uint32_t The ID of the timer
+     */
+    uint32_t add(const ::std::shared_ptr<Task>&,
+                 const ::sf::Time&,
+                 const bool& = false);
+
+    /**
+     * @brief Cancels a timer
+     * 
+     * @param id The ID of the timer
+     */
+    void remove(const uint32_t);
+
+    /**
+     * @brief Runs the tasks whose deadline has passed
+     * 
+     * @details Repeating timers are re-armed before their task runs, so a
+     * task that throws does not stop its timer.
+     * 
+     * @return true At least one task has been run
+     * @return false otherwise
+     */
+    bool runDue();
+
+    /**
+     * @brief Checks if any timer is scheduled
+     * 
+     * @return bool
+     */
+    bool empty() const;
+
+    /**
+     * @brief Returns the time left until the next deadline
+     * 
+     * @details Returns ::sf::Time::Zero if a deadline has already passed.
+     * Must not be called on an empty queue.
+     * 
+     * @return ::sf::Time
+     */
+    ::sf::Time getTimeUntilNext() const;
+ private:
+    struct Timer {
+        int64_t deadline;
+        int64_t period;
+        uint32_t id;
+        ::std::shared_ptr<Task> task;
+
+        bool operator> (const Timer&) const noexcept;
+    };
+
+    ::sf::Clock _clock;
+    ::std::vector<Timer> _heap;
+    ::std::unordered_set<uint32_t> _active;
+    uint32_t _nextId = 1;
+
+    /**
+     * @brief Drops removed timers from the top of the heap
+     * 
+     */
+    void discardRemoved();
+
+    /**
+     * @brief Returns the current time in microseconds
+     * 
+     * @return int64_t
+     */
+    int64_t now() const;
+};
+
+}  // namespace easyGUI
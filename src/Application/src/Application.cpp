@@ -27,8 +27,15 @@
  * @copyright Copyright (c) 2022
  */
 
+#include <algorithm>
 #include <iostream>
+#include <utility>
 
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Sleep.hpp>
+
+#include <ConstraintLayout.hpp>
+#include <AlignmentTool.hpp>
 #include <Application.hpp>
 
 
@@ -37,16 +44,36 @@ namespace easyGUI {
 // Defining the application instance
 std::shared_ptr<Application> Application::_instance = 0;
 
+// Longest sleep between two polls while waiting for events with a timeout
+static const ::sf::Time WAIT_SLICE = ::sf::milliseconds(5);
+
+// Shortest wait, used when a timer is already due or actions are posted
+static const ::sf::Time MIN_WAIT = ::sf::microseconds(1);
+
+// Longest wait while other threads may hand work to the UI thread
+static const ::sf::Time WAKE_TIMEOUT = ::sf::milliseconds(4);
+
 Application::Application(const uint32_t width,
                          const uint32_t height,
                          const char* title) {
     _window = ::std::make_shared<::sf::RenderWindow>
         (::sf::VideoMode(width, height), title);
+    _pacer = ::std::make_shared<FramePacer>(_window);
+    _executor = ::std::make_shared<Executor>();
+
+    TaskScheduler::setInstance(_executor.get());
+    ConstraintLayout::getInstance().setWindowArea(::sf::FloatRect(
+        0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height)));
 
     _startMenuSet = false;
+    _redrawOnDemand = false;
+    _idleTimeout = ::sf::Time::Zero;
+    _renderedFrames = 0;
+    _skippedFrames = 0;
     _activeMenu = nullptr;
-    _menus = ::std::map<::std::string, MenuPtr>();
+    _menus.clear();
     _routines = ::std::vector<Routine>();
+    _postPending = false;
 }
 
 ::std::shared_ptr<Application> Application::getInstance(
@@ -55,8 +82,8 @@ Application::Application(const uint32_t width,
         const char* title) {
     if (title != nullptr && width > 0 && height > 0) {
         if (_instance == nullptr) {
-            _instance = ::std::make_shared<Application>
-                (Application(width, height, title));
+            _instance = ::std::shared_ptr<Application>
+                (new Application(width, height, title));
         } else {
             // Adjust the window to the new configuration
             _instance->_window->setSize(::sf::Vector2u(width, height));
@@ -75,24 +102,23 @@ Application::Application(const uint32_t width,
 void Application::handleEvents(const ::sf::Event& event) {
     bool& boxClicked = TextBox::getTextBoxClicked();
     TextBox* box = TextBox::getSelectedBox();
-    ::std::vector<::std::shared_ptr<Component>> components =
-        _activeMenu->getAllComponents();
 
     if (event.type == ::sf::Event::MouseButtonPressed &&
         event.mouseButton.button == ::sf::Mouse::Left) {
+        const Point location = toWorld(event.mouseButton.x,
+                                       event.mouseButton.y);
         boxClicked = false;
-        ::std::for_each(components.begin(), components.end(),
-            [](::std::shared_ptr<Component>& comp) {
-                comp->onClick();
-        });
+
+        for (const auto& comp : _activeMenu->getComponentsAt(location))
+            comp->onClick(location);
 
         if (boxClicked == false)
             box = nullptr;
     } else if (event.type == ::sf::Event::MouseMoved) {
-        ::std::for_each(components.begin(), components.end(),
-            [](::std::shared_ptr<Component>& comp) {
-                comp->onHover();
-        });
+        _activeMenu->updateHover(
+            toWorld(event.mouseMove.x, event.mouseMove.y));
+    } else if (event.type == ::sf::Event::MouseLeft) {
+        _activeMenu->clearHover();
     } else if (event.type == ::sf::Event::TextEntered && box) {
         box->updateText(event.text.unicode);
     } else if (event.type == ::sf::Event::Resized) {
@@ -100,16 +126,52 @@ void Application::handleEvents(const ::sf::Event& event) {
         newView.setSize(event.size.width, event.size.height);
 
         _window->setView(newView);
+        _activeMenu->markDirty();
+
+        // The view stays centered, so the layout follows what it shows
+        const ::sf::Vector2f& center = newView.getCenter();
+        const ::sf::Vector2f& size = newView.getSize();
+
+        ConstraintLayout::getInstance().setWindowArea(::sf::FloatRect(
+            center.x - size.x / 2.0f, center.y - size.y / 2.0f,
+            size.x, size.y));
+    } else if (event.type == ::sf::Event::GainedFocus) {
+        // The window contents may have been lost while obscured
+        _activeMenu->markDirty();
     }
 
-    for (const Routine& routine : _routines) {
-        routine.operator()(event);
+    dispatchRoutines(event);
+}
+
+void Application::dispatchRoutines(const ::sf::Event& event) {
+    static const ::std::vector<uint32_t> noRoutines;
+
+    const ::std::vector<uint32_t>& typed = (event.type < ::sf::Event::Count) ?
+        _routinesByType[event.type] : noRoutines;
+    size_t nextTyped = 0;
+    size_t nextGeneric = 0;
+
+    // Both lists are sorted, so merging them keeps the order of addition
+    while (nextTyped < typed.size() ||
+           nextGeneric < _genericRoutines.size()) {
+        uint32_t index;
+
+        if (nextGeneric >= _genericRoutines.size() ||
+            (nextTyped < typed.size() &&
+             typed[nextTyped] < _genericRoutines[nextGeneric]))
+            index = typed[nextTyped++];
+        else
+            index = _genericRoutines[nextGeneric++];
+
+        _routines[index](event);
     }
 }
 
-::std::shared_ptr<Menu> Application::getMenu(const ::std::string& id) {
-    if (_menus.find(id) != _menus.end())
-        return _menus.at(id);
+::std::shared_ptr<Menu> Application::getMenu(const ::std::string_view id) {
+    auto it = _menus.find(id);
+
+    if (it != _menus.end())
+        return it->second;
 
     return nullptr;
 }
@@ -130,10 +192,11 @@ void Application::stop() {
 }
 
 ::std::shared_ptr<Menu> Application::addMenu(
-        const ::std::string& id,
+        const ::std::string_view id,
         const bool& isStart) {
     if (_menus.find(id) != _menus.end())
-        throw ApplicationException("A menu with this ID exists already: " + id);
+        throw ApplicationException("A menu with this ID exists already: " +
+                                   ::std::string(id));
 
     ::std::shared_ptr<Menu> newMenu = ::std::make_shared<Menu>();
     newMenu->setContainer(_window);
@@ -145,16 +208,22 @@ void Application::stop() {
         throw ApplicationException("Could not create initial menu because another initial menu has already been created."); // NOLINT
     }
 
-    _menus.emplace(id, newMenu);
+    _menus.emplace(::std::string(id), newMenu);
 
     return newMenu;
 }
 
-void Application::setActiveMenu(const ::std::string& id) {
-    if (_menus.find(id) != _menus.end()) {
+void Application::setActiveMenu(const ::std::string_view id) {
+    auto it = _menus.find(id);
+
+    if (it != _menus.end()) {
         TextBox* box = TextBox::getSelectedBox();
 
-        _activeMenu = _menus.at(id);
+        if (_activeMenu != nullptr)
+            _activeMenu->clearHover();
+
+        _activeMenu = it->second;
+        _activeMenu->markDirty();
 
         if (!_startMenuSet) {
             // A main menu can also be configured by manually setting
@@ -164,12 +233,28 @@ void Application::setActiveMenu(const ::std::string& id) {
             _startMenuSet = true;
         }
     } else {
-        throw MenuException("Could not get hold of menu wiht id: " + id);
+        throw MenuException("Could not get hold of menu wiht id: " +
+                            ::std::string(id));
     }
 }
 
 void Application::addRoutine(const Routine& routine) {
+    const uint32_t index = static_cast<uint32_t>(_routines.size());
+
     _routines.push_back(routine);
+
+    if (routine.getEventTypes().empty()) {
+        _genericRoutines.push_back(index);
+        return;
+    }
+
+    for (const ::sf::Event::EventType& type : routine.getEventTypes()) {
+        ::std::vector<uint32_t>& bucket = _routinesByType[type];
+
+        // A type listed twice must not fire the routine twice
+        if (bucket.empty() || bucket.back() != index)
+            bucket.push_back(index);
+    }
 }
 
 void Application::start() {
@@ -179,17 +264,200 @@ void Application::start() {
     while (_window->isOpen()) {
         ::sf::Event event;
 
+        if (_redrawOnDemand && !_activeMenu->isDirty()) {
+            // Nothing to present, so sleep until something happens
+            if (waitEvent(event, getWaitTimeout()))
+                handleEvents(event);
+
+            _pacer->pause();
+        }
+
+        _pacer->beginFrame();
+
         while (_window->pollEvent(event))
             handleEvents(event);
 
-        _window->clear();
-        _window->draw(*_activeMenu);
-        _window->display();
+        // Timer tasks usually update components behind the menu's back
+        if (_timers.runDue())
+            _activeMenu->markDirty();
+
+        _executor->drainCompletions();
+        runPostedActions();
+
+        _pacer->endPhase(FramePhase::EVENTS);
+
+        if (_redrawOnDemand && !_activeMenu->isDirty()) {
+            _skippedFrames++;
+            continue;
+        }
+
+        render();
+        _pacer->endFrame();
+    }
+}
+
+Point Application::toWorld(const int x, const int y) const {
+    return Point(_window->mapPixelToCoords(::sf::Vector2i(x, y)));
+}
+
+void Application::render() {
+    // Deferred layout is resolved once per frame, before drawing. The
+    // constraints go first, since the elements they move may be anchors.
+    ConstraintLayout::getInstance().update();
+    AlignmentTool::getInstance().solve();
+
+    _window->clear();
+    _window->draw(*_activeMenu);
+    _pacer->endPhase(FramePhase::DRAW);
+
+    _window->display();
+    _pacer->endPhase(FramePhase::DISPLAY);
+
+    _activeMenu->clearDirty();
+    _renderedFrames++;
+}
+
+bool Application::waitEvent(::sf::Event& event, const ::sf::Time& timeout) {
+    if (timeout == ::sf::Time::Zero)
+        return _window->waitEvent(event);
+
+    // SFML cannot wait with a timeout, so poll in short slices instead
+    ::sf::Clock clock;
+
+    while (!_window->pollEvent(event)) {
+        ::sf::Time remaining = timeout - clock.getElapsedTime();
+
+        if (remaining <= ::sf::Time::Zero || _postPending)
+            return false;
+
+        ::sf::sleep(::std::min(remaining, WAIT_SLICE));
+    }
+
+    return true;
+}
+
+static ::sf::Time limitTimeout(const ::sf::Time& timeout,
+                               const ::sf::Time& limit) {
+    // A zero timeout stands for an unlimited wait
+    if (timeout == ::sf::Time::Zero)
+        return limit;
+
+    return ::std::min(timeout, limit);
+}
+
+::sf::Time Application::getWaitTimeout() const {
+    ::sf::Time timeout = _idleTimeout;
+
+    if (_postPending)
+        return MIN_WAIT;
+
+    // SFML cannot be woken up from another thread, so the wait is bounded
+    // while asynchronous tasks may hand over work
+    if (_executor->isBusy())
+        timeout = limitTimeout(timeout, WAKE_TIMEOUT);
+
+    if (!_timers.empty()) {
+        timeout = limitTimeout(timeout,
+            ::std::max(_timers.getTimeUntilNext(), MIN_WAIT));
+    }
+
+    return timeout;
+}
+
+uint32_t Application::addTimer(const ::std::shared_ptr<Task>& task,
+                               const ::sf::Time& delay,
+                               const bool& repeat) {
+    return _timers.add(task, delay, repeat);
+}
+
+void Application::removeTimer(const uint32_t id) {
+    _timers.remove(id);
+}
+
+void Application::post(const ::std::function<void()>& action) {
+    if (!action)
+        return;
+
+    _posted.push(PostedAction{action, 0, false});
+    _postPending = true;
+}
+
+void Application::post(const uint64_t key,
+                       const ::std::function<void()>& action) {
+    if (!action)
+        return;
+
+    _posted.push(PostedAction{action, key, true});
+    _postPending = true;
+}
+
+void Application::runPostedActions() {
+    PostedAction posted;
+
+    // Cleared before draining, so that later posts raise it again
+    _postPending = false;
+
+    while (_posted.pop(posted))
+        _postedBatch.push_back(::std::move(posted));
+
+    if (_postedBatch.empty())
+        return;
+
+    // Walking backwards, the first action seen for a key is the latest one
+    for (auto it = _postedBatch.rbegin(); it != _postedBatch.rend(); ++it) {
+        if (it->coalesce && !_postedKeys.insert(it->key).second)
+            it->action = nullptr;
+    }
+
+    _postedKeys.clear();
+
+    // Taken out while running, so that a throwing action leaves no batch
+    ::std::vector<PostedAction> batch;
+    batch.swap(_postedBatch);
+
+    for (const PostedAction& element : batch) {
+        if (element.action)
+            element.action();
     }
+
+    // The storage is kept for the next batch
+    batch.clear();
+    _postedBatch.swap(batch);
+
+    // The actions usually update components behind the menu's back
+    if (_activeMenu != nullptr)
+        _activeMenu->markDirty();
+}
+
+void Application::setRedrawOnDemand(const bool& enabled) {
+    _redrawOnDemand = enabled;
+
+    if (_activeMenu != nullptr)
+        _activeMenu->markDirty();
+}
+
+void Application::setIdleTimeout(const ::sf::Time& timeout) {
+    _idleTimeout = timeout;
+}
+
+uint64_t Application::getRenderedFrames() const {
+    return _renderedFrames;
+}
+
+uint64_t Application::getSkippedFrames() const {
+    return _skippedFrames;
 }
 
 ::std::shared_ptr<::sf::RenderWindow> Application::getWindow() {
     return _window;
 }
 
+::std::shared_ptr<FramePacer> Application::getFramePacer() {
+    return _pacer;
+}
+
+::std::shared_ptr<Executor> Application::getExecutor() {
+    return _executor;
+}
+
 }  // namespace easyGUI
@@ -0,0 +1,313 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file BatchRenderer.cpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Implementation of the BatchRenderer class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#include <algorithm>
+
+#include <BatchRenderer.hpp>
+
+
+namespace easyGUI {
+
+static ::sf::FloatRect merge(const ::sf::FloatRect& first,
+                             const ::sf::FloatRect& second) {
+    const float left = ::std::min(first.left, second.left);
+    const float top = ::std::min(first.top, second.top);
+    const float right = ::std::max(first.left + first.width,
+                                   second.left + second.width);
+    const float bottom = ::std::max(first.top + first.height,
+                                    second.top + second.height);
+
+    return ::sf::FloatRect(left, top, right - left, bottom - top);
+}
+
+void BatchRenderer::invalidate() {
+    _valid = false;
+}
+
+void BatchRenderer::update(const ComponentRange& components) {
+    if (!_valid) {
+        _geometries.resize(components.size());
+        _batched.assign(components.size(), false);
+
+        for (size_t i = 0; i < components.size(); ++i) {
+            _geometries[i].clear();
+            _batched[i] = components[i]->buildGeometry(_geometries[i]);
+        }
+
+        rebuildBatches(components);
+        _valid = true;
+
+        return;
+    }
+
+    bool rebuild = false;
+
+    for (size_t i = 0; i < components.size(); ++i) {
+        const Component& component = *components[i];
+
+        if (!component.isDirty())
+            continue;
+
+        if (rebuild) {
+            _geometries[i].clear();
+            _batched[i] = component.buildGeometry(_geometries[i]);
+            continue;
+        }
+
+        _scratch.clear();
+
+        const bool batched = component.buildGeometry(_scratch);
+
+        rebuild = !patch(i, component, batched, _scratch);
+
+        _geometries[i] = _scratch;
+        _batched[i] = batched;
+    }
+
+    if (rebuild)
+        rebuildBatches(components);
+}
+
+bool BatchRenderer::patch(const size_t index,
+                          const Component& component,
+                          const bool batched,
+                          const Geometry& geometry) {
+    if (batched != _batched[index])
+        return false;
+
+    if (!batched) {
+        // Nothing was placed according to the area of the component
+        _batches[_placement[index]].bounds = component.getExtent();
+        return true;
+    }
+
+    const ::std::vector<Geometry::Primitive>& previous =
+        _geometries[index].getPrimitives();
+    const ::std::vector<Geometry::Primitive>& primitives =
+        geometry.getPrimitives();
+
+    if (previous.size() != primitives.size())
+        return false;
+
+    const uint32_t first = _placement[index];
+    const uint32_t last = first + static_cast<uint32_t>(primitives.size());
+
+    for (uint32_t i = 0; i < primitives.size(); ++i) {
+        const Geometry::Primitive& primitive = primitives[i];
+
+        if (primitive.texture != previous[i].texture ||
+            primitive.drawable != previous[i].drawable ||
+            primitive.count != previous[i].count ||
+            !canMove(first + i, primitive.bounds, first, last))
+            return false;
+
+        // The primitives of the component keep their relative order
+        for (uint32_t j = 0; j < i; ++j) {
+            if (_itemBatch[first + j] > _itemBatch[first + i] &&
+                primitives[j].bounds.intersects(primitive.bounds))
+                return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < primitives.size(); ++i) {
+        const Geometry::Primitive& primitive = primitives[i];
+        const uint32_t item = first + i;
+        Batch& batch = _batches[_itemBatch[item]];
+
+        if (primitive.drawable) {
+            batch.bounds = primitive.bounds;
+        } else {
+            const auto source = geometry.getVertices().begin() +
+                                primitive.first;
+
+            ::std::copy(source, source + primitive.count,
+                        batch.vertices.begin() + _itemOffset[item]);
+
+            // Batches only grow until the next rebuild
+            batch.bounds = merge(batch.bounds, primitive.bounds);
+        }
+
+        _grid.update(item, _itemBounds[item], primitive.bounds);
+        _itemBounds[item] = primitive.bounds;
+    }
+
+    return true;
+}
+
+bool BatchRenderer::canMove(const uint32_t item,
+                            const ::sf::FloatRect& bounds,
+                            const uint32_t first,
+                            const uint32_t last) {
+    const uint32_t batch = _itemBatch[item];
+
+    _candidates.clear();
+    _grid.query(bounds, _candidates);
+
+    for (const uint32_t other : _candidates) {
+        if ((other >= first && other < last) ||
+            !_itemBounds[other].intersects(bounds))
+            continue;
+
+        // Earlier items must not be drawn after it, nor later ones before
+        if (other < item ? _itemBatch[other] > batch
+                         : _itemBatch[other] < batch)
+            return false;
+    }
+
+    return true;
+}
+
+uint32_t BatchRenderer::addBatch(const ::sf::Texture* texture,
+                                 const ::sf::Drawable* drawable,
+                                 const ::sf::FloatRect& bounds) {
+    // Batches are reused between rebuilds, so that their vertex
+    // buffers keep their capacity
+    if (_batchCount == _batches.size())
+        _batches.emplace_back();
+
+    Batch& batch = _batches[_batchCount];
+
+    batch.texture = texture;
+    batch.drawable = drawable;
+    batch.vertices.clear();
+    batch.bounds = bounds;
+
+    return static_cast<uint32_t>(_batchCount++);
+}
+
+void BatchRenderer::rebuildBatches(const ComponentRange& components) {
+    _batchCount = 0;
+    _batchesByTexture.clear();
+
+    _grid.clear();
+    _itemBatch.clear();
+    _itemOffset.clear();
+    _itemBounds.clear();
+    _barrier = 0;
+
+    _placement.resize(components.size());
+
+    for (size_t i = 0; i < components.size(); ++i) {
+        if (!_batched[i]) {
+            // Nothing is known about what the component draws
+            _barrier = addBatch(nullptr, components[i].get(),
+                                components[i]->getExtent());
+            _placement[i] = _barrier;
+            continue;
+        }
+
+        const Geometry& geometry = _geometries[i];
+
+        _placement[i] = static_cast<uint32_t>(_itemBatch.size());
+
+        for (const Geometry::Primitive& primitive : geometry.getPrimitives())
+            place(primitive, geometry);
+    }
+}
+
+void BatchRenderer::place(const Geometry::Primitive& primitive,
+                          const Geometry& geometry) {
+    // The primitive must be drawn after everything it overlaps
+    uint32_t lowest = _barrier;
+
+    _candidates.clear();
+    _grid.query(primitive.bounds, _candidates);
+
+    for (const uint32_t item : _candidates) {
+        if (_itemBounds[item].intersects(primitive.bounds))
+            lowest = ::std::max(lowest, _itemBatch[item]);
+    }
+
+    uint32_t target;
+    uint32_t offset = 0;
+
+    if (primitive.drawable) {
+        target = addBatch(nullptr, primitive.drawable, primitive.bounds);
+    } else {
+        ::std::vector<uint32_t>& batches = _batchesByTexture[primitive.texture];
+        auto it = ::std::lower_bound(batches.begin(), batches.end(), lowest);
+
+        if (it != batches.end()) {
+            target = *it;
+            _batches[target].bounds = merge(_batches[target].bounds,
+                                            primitive.bounds);
+        } else {
+            target = addBatch(primitive.texture, nullptr, primitive.bounds);
+            batches.push_back(target);
+        }
+
+        const auto first = geometry.getVertices().begin() + primitive.first;
+        ::std::vector<::sf::Vertex>& vertices = _batches[target].vertices;
+
+        offset = static_cast<uint32_t>(vertices.size());
+        vertices.insert(vertices.end(), first, first + primitive.count);
+    }
+
+    const uint32_t item = static_cast<uint32_t>(_itemBatch.size());
+
+    _itemBatch.push_back(target);
+    _itemOffset.push_back(offset);
+    _itemBounds.push_back(primitive.bounds);
+    _grid.insert(item, primitive.bounds);
+}
+
+void BatchRenderer::drawBatch(::sf::RenderTarget& target,
+                              const ::sf::RenderStates& states,
+                              const Batch& batch) const {
+    if (batch.drawable) {
+        target.draw(*batch.drawable, states);
+    } else if (!batch.vertices.empty()) {
+        ::sf::RenderStates batchStates = states;
+
+        batchStates.texture = batch.texture;
+        target.draw(batch.vertices.data(), batch.vertices.size(),
+                    ::sf::Triangles, batchStates);
+    }
+}
+
+void BatchRenderer::draw(::sf::RenderTarget& target,
+                         ::sf::RenderStates states) const {
+    for (size_t i = 0; i < _batchCount; ++i)
+        drawBatch(target, states, _batches[i]);
+}
+
+void BatchRenderer::draw(::sf::RenderTarget& target,
+                         ::sf::RenderStates states,
+                         const ::sf::FloatRect& area) const {
+    for (size_t i = 0; i < _batchCount; ++i) {
+        if (_batches[i].bounds.intersects(area))
+            drawBatch(target, states, _batches[i]);
+    }
+}
+
+size_t BatchRenderer::getBatchCount() const {
+    return _batchCount;
+}
+
+}  // namespace easyGUI
@@ -0,0 +1,189 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file ComponentStore.cpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Implementation of the ComponentStore class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#include <ComponentStore.hpp>
+#include <Exceptions/MenuException.hpp>
+
+
+namespace easyGUI {
+
+ComponentHandle ComponentStore::insert(
+    const ::std::shared_ptr<Component>& component,
+    const ::sf::FloatRect& bounds) {
+    uint32_t index;
+
+    if (!_freeSlots.empty()) {
+        index = _freeSlots.back();
+        _freeSlots.pop_back();
+    } else {
+        if (_slots.size() > ComponentHandle::INDEX_MASK)
+            throw MenuException("The menu cannot hold any more components");
+
+        index = static_cast<uint32_t>(_slots.size());
+        _slots.emplace_back();
+    }
+
+    Slot& slot = _slots[index];
+    const ComponentHandle handle(index, slot.generation);
+
+    slot.dense = static_cast<uint32_t>(_components.size());
+
+    _components.push_back(component);
+    _bounds.push_back(bounds);
+    _layers.push_back(0);
+    _flags.push_back(0);
+    _handles.push_back(handle);
+
+    return handle;
+}
+
+bool ComponentStore::remove(const ComponentHandle& handle) {
+    const uint32_t dense = getDenseIndex(handle);
+
+    if (dense == INVALID_INDEX)
+        return false;
+
+    // Erasing keeps the insertion order of the remaining components
+    const auto offset = static_cast<ptrdiff_t>(dense);
+
+    _components.erase(_components.begin() + offset);
+    _bounds.erase(_bounds.begin() + offset);
+    _layers.erase(_layers.begin() + offset);
+    _flags.erase(_flags.begin() + offset);
+    _handles.erase(_handles.begin() + offset);
+
+    for (size_t i = dense; i < _handles.size(); ++i)
+        _slots[_handles[i].getIndex()].dense = static_cast<uint32_t>(i);
+
+    release(handle.getIndex());
+
+    return true;
+}
+
+void ComponentStore::clear() {
+    for (const ComponentHandle& handle : _handles)
+        release(handle.getIndex());
+
+    _components.clear();
+    _bounds.clear();
+    _layers.clear();
+    _flags.clear();
+    _handles.clear();
+}
+
+void ComponentStore::release(const uint32_t index) {
+    Slot& slot = _slots[index];
+
+    slot.dense = INVALID_INDEX;
+    slot.generation = (slot.generation + 1) & ComponentHandle::GENERATION_MASK;
+
+    // Generation 0 is skipped so that the null handle is never valid
+    if (slot.generation == 0)
+        slot.generation = 1;
+
+    _freeSlots.push_back(index);
+}
+
+bool ComponentStore::isValid(const ComponentHandle& handle) const {
+    return getDenseIndex(handle) != INVALID_INDEX;
+}
+
+::std::shared_ptr<Component> ComponentStore::get(
+    const ComponentHandle& handle) const {
+    const uint32_t dense = getDenseIndex(handle);
+
+    if (dense == INVALID_INDEX)
+        return nullptr;
+
+    return _components[dense];
+}
+
+uint32_t ComponentStore::getDenseIndex(const ComponentHandle& handle) const {
+    const uint32_t index = handle.getIndex();
+
+    if (handle.isNull() || index >= _slots.size())
+        return INVALID_INDEX;
+
+    const Slot& slot = _slots[index];
+
+    if (slot.generation != handle.getGeneration())
+        return INVALID_INDEX;
+
+    return slot.dense;
+}
+
+size_t ComponentStore::size() const {
+    return _components.size();
+}
+
+ComponentRange ComponentStore::getComponents() const {
+    return ComponentRange(_components.data(),
+                          _components.data() + _components.size());
+}
+
+const ::std::shared_ptr<Component>& ComponentStore::getComponent(
+    const uint32_t index) const {
+    return _components[index];
+}
+
+ComponentHandle ComponentStore::getHandle(const uint32_t index) const {
+    return _handles[index];
+}
+
+const ::sf::FloatRect& ComponentStore::getBounds(const uint32_t index) const {
+    return _bounds[index];
+}
+
+void ComponentStore::setBounds(const uint32_t index,
+                               const ::sf::FloatRect& bounds) {
+    _bounds[index] = bounds;
+}
+
+int32_t ComponentStore::getLayer(const uint32_t index) const {
+    return _layers[index];
+}
+
+void ComponentStore::setLayer(const uint32_t index, const int32_t layer) {
+    _layers[index] = layer;
+}
+
+uint8_t ComponentStore::getFlags(const uint32_t index) const {
+    return _flags[index];
+}
+
+void ComponentStore::setFlags(const uint32_t index,
+                              const uint8_t flags,
+                              const bool& value) {
+    if (value)
+        _flags[index] = static_cast<uint8_t>(_flags[index] | flags);
+    else
+        _flags[index] = static_cast<uint8_t>(_flags[index] & ~flags);
+}
+
+}  // namespace easyGUI
@@ -0,0 +1,187 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file Executor.cpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Implementation of the Executor class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#include <exception>
+
+#include <Exceptions/ApplicationException.hpp>
+#include <Executor.hpp>
+
+
+namespace easyGUI {
+
+// Identifies the executor and worker running on the current thread
+static thread_local const Executor* currentExecutor = nullptr;
+static thread_local uint32_t currentWorker = 0;
+
+Executor::Executor(const uint32_t threads) :
+    _running(true),
+    _nextWorker(0),
+    _queued(0),
+    _inFlight(0) {
+    _threadCount = threads;
+
+    if (_threadCount == 0) {
+        const uint32_t cores = ::std::thread::hardware_concurrency();
+
+        // Leave a core for the UI thread
+        _threadCount = cores > 1 ? cores - 1 : 1;
+    }
+}
+
+Executor::~Executor() {
+    {
+        ::std::lock_guard<::std::mutex> guard(_sleepLock);
+        _running = false;
+    }
+
+    _wakeUp.notify_all();
+
+    for (auto& worker : _workers) {
+        if (worker->thread.joinable())
+            worker->thread.join();
+    }
+
+    if (TaskScheduler::getInstance() == this)
+        TaskScheduler::setInstance(nullptr);
+}
+
+void Executor::start() {
+    for (uint32_t index = 0; index < _threadCount; ++index)
+        _workers.push_back(::std::make_unique<Worker>());
+
+    for (uint32_t index = 0; index < _threadCount; ++index)
+        _workers[index]->thread = ::std::thread(&Executor::work, this, index);
+}
+
+void Executor::schedule(const ::std::shared_ptr<Task>& task) {
+    if (task == nullptr)
+        return;
+
+    ::std::call_once(_started, &Executor::start, this);
+
+    uint32_t target;
+
+    if (currentExecutor == this)
+        // Tasks spawned by a worker stay on that worker
+        target = currentWorker;
+    else
+        target = _nextWorker.fetch_add(1) % _threadCount;
+
+    _inFlight++;
+
+    {
+        ::std::lock_guard<::std::mutex> guard(_workers[target]->lock);
+        _workers[target]->tasks.push_back(task);
+    }
+
+    {
+        ::std::lock_guard<::std::mutex> guard(_sleepLock);
+        _queued++;
+    }
+
+    _wakeUp.notify_one();
+}
+
+bool Executor::takeTask(const uint32_t index, ::std::shared_ptr<Task>& task) {
+    {
+        Worker& own = *_workers[index];
+        ::std::lock_guard<::std::mutex> guard(own.lock);
+
+        if (!own.tasks.empty()) {
+            task = ::std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    for (uint32_t offset = 1; offset < _threadCount; ++offset) {
+        Worker& victim = *_workers[(index + offset) % _threadCount];
+        ::std::lock_guard<::std::mutex> guard(victim.lock);
+
+        if (!victim.tasks.empty()) {
+            task = ::std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Executor::work(const uint32_t index) {
+    currentExecutor = this;
+    currentWorker = index;
+
+    while (_running) {
+        ::std::shared_ptr<Task> task;
+
+        if (takeTask(index, task)) {
+            _queued--;
+
+            try {
+                task->exec();
+                _completed.push(task);
+            }
+            catch (const ::std::exception& err) {
+                ERROR << "Asynchronous task failed: " << err.what() << "\n";
+                _inFlight--;
+            }
+            catch (...) {
+                ERROR << "Asynchronous task failed: unknown exception\n";
+                _inFlight--;
+            }
+
+            continue;
+        }
+
+        ::std::unique_lock<::std::mutex> guard(_sleepLock);
+        _wakeUp.wait(guard, [this]() {
+            return !_running || _queued > 0;
+        });
+    }
+}
+
+void Executor::drainCompletions() {
+    ::std::shared_ptr<Task> task;
+
+    while (_completed.pop(task)) {
+        _inFlight--;
+        task->onComplete();
+    }
+}
+
+bool Executor::isBusy() const {
+    return _inFlight > 0;
+}
+
+uint32_t Executor::getThreadCount() const {
+    return _threadCount;
+}
+
+}  // namespace easyGUI
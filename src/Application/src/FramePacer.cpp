@@ -0,0 +1,199 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file FramePacer.cpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Implementation of the FramePacer class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include <SFML/System/Sleep.hpp>
+
+#include <FramePacer.hpp>
+
+
+namespace easyGUI {
+
+// Weight of the newest oversleep measurement
+static const double OVERSLEEP_SMOOTHING = 0.1;
+
+// How many deviations of oversleep are kept as a safety margin
+static const double OVERSLEEP_SPREAD = 3.0;
+
+FramePacer::FramePacer(const ::std::shared_ptr<::sf::RenderWindow>& window):
+    _window(window),
+    _targetFPS(0),
+    _verticalSync(false),
+    _sleepMode(SleepMode::COARSE),
+    _deadline(0),
+    _phaseStart(0),
+    _lastFrameEnd(-1),
+    _oversleepMean(500.0),
+    _oversleepDeviation(250.0) {
+    for (uint32_t series = 0; series < SERIES_COUNT; ++series) {
+        _samples[series].reserve(SAMPLE_COUNT);
+        _nextSample[series] = 0;
+    }
+}
+
+void FramePacer::setTargetFPS(const uint32_t fps) {
+    _targetFPS = fps;
+}
+
+uint32_t FramePacer::getTargetFPS() const {
+    return _targetFPS;
+}
+
+void FramePacer::setVerticalSync(const bool& enabled) {
+    _verticalSync = enabled;
+
+    if (_window != nullptr)
+        _window->setVerticalSyncEnabled(enabled);
+}
+
+bool FramePacer::isVerticalSyncEnabled() const {
+    return _verticalSync;
+}
+
+void FramePacer::setSleepMode(const SleepMode& mode) {
+    _sleepMode = mode;
+}
+
+SleepMode FramePacer::getSleepMode() const {
+    return _sleepMode;
+}
+
+int64_t FramePacer::now() const {
+    return _clock.getElapsedTime().asMicroseconds();
+}
+
+void FramePacer::beginFrame() {
+    _phaseStart = now();
+}
+
+void FramePacer::endPhase(const FramePhase& phase) {
+    const int64_t current = now();
+
+    record(static_cast<uint32_t>(phase), current - _phaseStart);
+    _phaseStart = current;
+}
+
+void FramePacer::endFrame() {
+    if (_targetFPS > 0) {
+        const int64_t period = 1000000 / static_cast<int64_t>(_targetFPS);
+        const int64_t current = now();
+
+        // Deadlines advance by a fixed period so the average rate is exact
+        _deadline += period;
+
+        if (_deadline < current)
+            // The frame ran late, do not try to catch up
+            _deadline = current;
+        else
+            sleepUntil(_deadline);
+    }
+
+    const int64_t end = now();
+
+    if (_lastFrameEnd >= 0)
+        record(FRAME_SERIES, end - _lastFrameEnd);
+
+    _lastFrameEnd = end;
+}
+
+void FramePacer::pause() {
+    // The next frame starts a new sequence of intervals
+    _lastFrameEnd = -1;
+}
+
+void FramePacer::sleepUntil(const int64_t deadline) {
+    const int64_t margin = getSleepMargin().asMicroseconds();
+    const int64_t wakeUp = deadline - margin;
+    const int64_t current = now();
+
+    if (wakeUp > current) {
+        ::sf::sleep(::sf::microseconds(wakeUp - current));
+
+        // Learn how much the operating system oversleeps
+        const double error = static_cast<double>(now() - wakeUp);
+
+        _oversleepDeviation += OVERSLEEP_SMOOTHING *
+            (::std::fabs(error - _oversleepMean) - _oversleepDeviation);
+        _oversleepMean += OVERSLEEP_SMOOTHING * (error - _oversleepMean);
+    }
+
+    if (_sleepMode == SleepMode::PRECISE) {
+        while (now() < deadline)
+            ::std::this_thread::yield();
+    }
+}
+
+void FramePacer::record(const uint32_t series, const int64_t value) {
+    ::std::vector<int64_t>& samples = _samples[series];
+
+    if (samples.size() < SAMPLE_COUNT) {
+        samples.push_back(value);
+    } else {
+        samples[_nextSample[series]] = value;
+        _nextSample[series] = (_nextSample[series] + 1) % SAMPLE_COUNT;
+    }
+}
+
+::sf::Time FramePacer::percentileOf(const uint32_t series,
+                                    const float& percentile) const {
+    if (_samples[series].empty())
+        return ::sf::Time::Zero;
+
+    ::std::vector<int64_t> sorted = _samples[series];
+    const float clamped = ::std::min(1.0f, ::std::max(0.0f, percentile));
+    const size_t index = static_cast<size_t>(
+        clamped * static_cast<float>(sorted.size() - 1));
+
+    ::std::nth_element(sorted.begin(),
+                       sorted.begin() + static_cast<ptrdiff_t>(index),
+                       sorted.end());
+
+    return ::sf::microseconds(sorted[index]);
+}
+
+::sf::Time FramePacer::getPhaseTime(const FramePhase& phase,
+                                    const float& percentile) const {
+    return percentileOf(static_cast<uint32_t>(phase), percentile);
+}
+
+::sf::Time FramePacer::getFrameTime(const float& percentile) const {
+    return percentileOf(FRAME_SERIES, percentile);
+}
+
+::sf::Time FramePacer::getSleepMargin() const {
+    const double margin =
+        _oversleepMean + OVERSLEEP_SPREAD * _oversleepDeviation;
+
+    return ::sf::microseconds(static_cast<int64_t>(::std::max(0.0, margin)));
+}
+
+}  // namespace easyGUI
@@ -0,0 +1,116 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file LayerCache.cpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Implementation of the LayerCache class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#include <LayerCache.hpp>
+
+
+namespace easyGUI {
+
+static bool sameView(const ::sf::View& first, const ::sf::View& second) {
+    return first.getCenter() == second.getCenter() &&
+           first.getSize() == second.getSize() &&
+           first.getRotation() == second.getRotation() &&
+           first.getViewport() == second.getViewport();
+}
+
+void LayerCache::invalidate() {
+    _valid = false;
+}
+
+bool LayerCache::isValid(const ::sf::RenderTarget& target) const {
+    return _valid && _size == target.getSize() &&
+           sameView(_view, target.getView());
+}
+
+bool LayerCache::begin(const ::sf::RenderTarget& target) {
+    const ::sf::Vector2u size = target.getSize();
+
+    // Creation is only attempted again once the size changes
+    if (_failed && _size == size)
+        return false;
+
+    if (!_texture || _size != size) {
+        if (!_texture)
+            _texture = ::std::make_unique<::sf::RenderTexture>();
+
+        _size = size;
+        _valid = false;
+
+        if (!_texture->create(size.x, size.y)) {
+            ERROR << "[LayerCache] Could not create the render texture.\n";
+
+            _texture.reset();
+            _failed = true;
+
+            return false;
+        }
+
+        _failed = false;
+        _sprite.setTexture(_texture->getTexture(), true);
+    }
+
+    _view = target.getView();
+
+    _texture->setView(_view);
+    _texture->clear(::sf::Color::Transparent);
+
+    return true;
+}
+
+void LayerCache::add(const Component& component,
+                     const ::sf::RenderStates& states) {
+    _texture->draw(component, states);
+}
+
+void LayerCache::end() {
+    _texture->display();
+    _valid = true;
+}
+
+void LayerCache::draw(::sf::RenderTarget& target) const {
+    // The texture already holds colors multiplied by their alpha
+    static const ::sf::RenderStates premultiplied(::sf::BlendMode(
+        ::sf::BlendMode::One, ::sf::BlendMode::OneMinusSrcAlpha));
+
+    const ::sf::View view = target.getView();
+
+    // The texture covers the whole target, pixel for pixel
+    target.setView(target.getDefaultView());
+    target.draw(_sprite, premultiplied);
+    target.setView(view);
+}
+
+void LayerCache::release() {
+    _texture.reset();
+    _size = ::sf::Vector2u();
+    _valid = false;
+    _failed = false;
+}
+
+}  // namespace easyGUI
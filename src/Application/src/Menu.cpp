@@ -27,48 +27,671 @@
  * @copyright Copyright (c) 2022
  */
 
+#include <algorithm>
+#include <utility>
+
 #include <Menu.hpp>
 
 
 namespace easyGUI {
 
-void Menu::addComponent(const std::shared_ptr<Component>& component,
-                        const ::std::string& ID) {
-    if (_components.find(ID) != _components.end())
-        throw MenuException("A component with that ID already exists: " + ID);
+static ::sf::FloatRect getVisibleArea(const ::sf::RenderTarget& target,
+                                      const ::sf::RenderStates& states) {
+    const ::sf::View& view = target.getView();
+
+    // The view maps this rectangle to the whole viewport
+    const ::sf::FloatRect area = view.getInverseTransform().transformRect(
+        ::sf::FloatRect(-1, -1, 2, 2));
+
+    return states.transform.getInverse().transformRect(area);
+}
+
+Menu::Menu() {
+    _bindingScope = AlignmentTool::getInstance().createScope();
+}
+
+Menu::~Menu() {
+    for (const auto& component : _store.getComponents())
+        component->removeObserver(this);
+
+    AlignmentTool* tool = AlignmentTool::getLiveInstance();
+
+    if (tool)
+        tool->releaseScope(_bindingScope);
+}
+
+ComponentHandle Menu::addComponent(
+    const std::shared_ptr<Component>& component,
+    const ::std::string_view ID) {
+    const ComponentId key(ID);
+    auto it = _index.find(key.getHash());
+
+    if (it != _index.end()) {
+        if (it->second.name == ID)
+            throw MenuException("A component with that ID already exists: " +
+                                ::std::string(ID));
+
+        throw MenuException("The ID " + ::std::string(ID) +
+                            " collides with " + it->second.name);
+    }
+
+    const ::sf::FloatRect bounds = component->getExtent();
+    const ComponentHandle handle = _store.insert(component, bounds);
+
+    _index.emplace(key.getHash(), IndexEntry{handle, ::std::string(ID)});
+    _handleOf[component.get()] = handle;
+    _grid.insert(handle.getValue(), bounds);
 
-    _components.emplace(ID, component);
     component->setContainer(_container);
+    component->addObserver(this);
+
+    insertDrawOrder(_store.getDenseIndex(handle));
+    invalidateDrawList();
+
+    return handle;
+}
+
+bool Menu::removeComponent(const ::std::string_view ID) {
+    const IndexEntry* entry = find(ComponentId(ID));
+
+    // Removal is rare, so the ID is verified in every build
+    if (!entry || entry->name != ID)
+        return false;
+
+    const ComponentHandle handle = entry->handle;
+    const uint32_t dense = _store.getDenseIndex(handle);
+    const ::std::shared_ptr<Component> component =
+        _store.getComponent(dense);
+
+    _grid.remove(handle.getValue(), _store.getBounds(dense));
+    eraseDrawOrder(dense);
+    _store.remove(handle);
+    _index.erase(ComponentId::hash(ID));
+    _handleOf.erase(component.get());
+
+    _hovered.erase(::std::remove(_hovered.begin(), _hovered.end(), component),
+                   _hovered.end());
+
+    component->removeObserver(this);
+
+    invalidateDrawList();
+
+    return true;
+}
+
+void Menu::onComponentUpdate(Component& component) {
+    // Components report every change here, so the menu never scans them
+    _dirty = true;
+
+    auto it = _handleOf.find(&component);
+
+    if (it == _handleOf.end())
+        return;
+
+    const ComponentHandle handle = it->second;
+    const uint32_t dense = _store.getDenseIndex(handle);
+    const ::sf::FloatRect bounds = component.getExtent();
+
+    if (bounds != _store.getBounds(dense)) {
+        _grid.update(handle.getValue(), _store.getBounds(dense), bounds);
+        _store.setBounds(dense, bounds);
+    }
+
+    // Components drawn on top of the cache can change freely
+    if (dense < _cached.size() && _cached[dense])
+        _cache.invalidate();
+}
+
+ComponentRange Menu::getComponents() const {
+    return _store.getComponents();
+}
+
+ComponentRange Menu::getComponentsAt(const Point& point) {
+    _candidates.clear();
+    _hits.clear();
+
+    _grid.query(point, _candidates);
+
+    for (uint32_t& candidate : _candidates)
+        candidate = _store.getDenseIndex(ComponentHandle(candidate));
+
+    _candidates.erase(::std::remove_if(_candidates.begin(), _candidates.end(),
+        [this, &point](const uint32_t dense) {
+            if (dense == ComponentStore::INVALID_INDEX ||
+                (_store.getFlags(dense) & (HIDDEN | DISABLED)) ||
+                !_store.getBounds(dense).contains(point.Xcoord, point.Ycoord))
+                return true;
+
+            // Components without bounds are found everywhere
+            const Component& component = *_store.getComponent(dense);
+
+            return !component.hasBounds() && !component.isMouseHover(point);
+    }), _candidates.end());
+
+    // Topmost components are drawn last
+    ::std::sort(_candidates.begin(), _candidates.end(),
+        [this](const uint32_t first, const uint32_t second) {
+            return _drawRank[first] > _drawRank[second];
+    });
+
+    for (const uint32_t dense : _candidates)
+        _hits.push_back(_store.getComponent(dense));
+
+    return ComponentRange(_hits.data(), _hits.data() + _hits.size());
 }
 
 void Menu::draw(::sf::RenderTarget& target,
                 ::sf::RenderStates states) const {
-    for (const auto& element : _components)
-        target.draw(*element.second, states);
+    if (_caching && drawCached(target, states))
+        return;
+
+    if (_batching) {
+        _renderer.update(getDrawList());
+
+        if (_culling)
+            _renderer.draw(target, states, getVisibleArea(target, states));
+        else
+            _renderer.draw(target, states);
+
+        return;
+    }
+
+    if (_staticDispatch) {
+        if (!_dispatchValid) {
+            _dispatcher.rebuild(getDrawList());
+            _dispatchValid = true;
+        }
+
+        _dispatcher.draw(target, states);
+        return;
+    }
+
+    if (_culling) {
+        for (const uint32_t dense :
+             findVisible(getVisibleArea(target, states)))
+            target.draw(*_store.getComponent(dense), states);
+
+        return;
+    }
+
+    for (const auto& component : getDrawList())
+        target.draw(*component, states);
+}
+
+const ::std::vector<uint32_t>& Menu::findVisible(
+    const ::sf::FloatRect& area) const {
+    _visible.clear();
+    _grid.query(area, _visible);
+
+    for (uint32_t& candidate : _visible)
+        candidate = _store.getDenseIndex(ComponentHandle(candidate));
+
+    _visible.erase(::std::remove_if(_visible.begin(), _visible.end(),
+        [this, &area](const uint32_t dense) {
+            return dense == ComponentStore::INVALID_INDEX ||
+                   (_store.getFlags(dense) & HIDDEN) ||
+                   !_store.getBounds(dense).intersects(area);
+    }), _visible.end());
+
+    ::std::sort(_visible.begin(), _visible.end(),
+        [this](const uint32_t first, const uint32_t second) {
+            return _drawRank[first] < _drawRank[second];
+    });
+
+    // Components spanning several cells are found more than once
+    _visible.erase(::std::unique(_visible.begin(), _visible.end()),
+                   _visible.end());
+
+    return _visible;
+}
+
+bool Menu::drawCached(::sf::RenderTarget& target,
+                      const ::sf::RenderStates& states) const {
+    bool valid = _cache.isValid(target);
+
+    // Components that settled down since the cache was rendered join it
+    for (size_t i = 0; valid && i < _live.size(); ++i) {
+        const uint32_t dense = _live[i];
+
+        if (!(_store.getFlags(dense) & DYNAMIC) &&
+            !_store.getComponent(dense)->isDirty())
+            valid = false;
+    }
+
+    if (!valid) {
+        if (!_cache.begin(target))
+            return false;
+
+        _cached.assign(_store.size(), false);
+        _live.clear();
+
+        for (const uint32_t dense : _drawOrder) {
+            const uint8_t flags = _store.getFlags(dense);
+            const Component& component = *_store.getComponent(dense);
+
+            if (flags & HIDDEN)
+                continue;
+
+            if ((flags & DYNAMIC) || component.isDirty()) {
+                _live.push_back(dense);
+            } else {
+                _cache.add(component, states);
+                _cached[dense] = true;
+            }
+        }
+
+        _cache.end();
+    }
+
+    _cache.draw(target);
+
+    const ::sf::FloatRect area = getVisibleArea(target, states);
+
+    for (const uint32_t dense : _live) {
+        if (!_culling || _store.getBounds(dense).intersects(area))
+            target.draw(*_store.getComponent(dense), states);
+    }
+
+    return true;
+}
+
+::std::shared_ptr<Component> Menu::getComponent(
+    const ::std::string_view ID) {
+    return getComponent(ComponentId(ID));
 }
 
-::std::shared_ptr<Component> Menu::getComponent(const ::std::string& ID) {
-    if (_components.find(ID) != _components.end())
-        return _components.at(ID);
+::std::shared_ptr<Component> Menu::getComponent(const ComponentId& ID) {
+    const IndexEntry* entry = find(ID);
+
+    if (entry)
+        return _store.get(entry->handle);
 
     return nullptr;
 }
 
+::std::shared_ptr<Component> Menu::getComponent(
+    const ComponentHandle& handle) {
+    return _store.get(handle);
+}
+
+ComponentHandle Menu::getHandle(const ::std::string_view ID) const {
+    return getHandle(ComponentId(ID));
+}
+
+ComponentHandle Menu::getHandle(const ComponentId& ID) const {
+    const IndexEntry* entry = find(ID);
+
+    if (entry)
+        return entry->handle;
+
+    return ComponentHandle();
+}
+
+const Menu::IndexEntry* Menu::find(const ComponentId& ID) const {
+    auto it = _index.find(ID.getHash());
+
+    if (it == _index.end())
+        return nullptr;
+
+#ifndef NDEBUG
+    if (it->second.name != ID.getName()) {
+        ERROR << "Component ID " << ID.getName() << " collides with "
+              << it->second.name << ".\n";
+
+        return nullptr;
+    }
+#endif
+
+    return &it->second;
+}
+
 ::std::vector<::std::shared_ptr<Component>> Menu::getAllComponents() {
-    ::std::vector<::std::shared_ptr<Component>> temp;
-    ::std::transform(
-        _components.begin(),
-        _components.end(),
-        ::std::back_inserter(temp),
-        [](const ::std::pair<::std::string, ::std::shared_ptr<Component>>& el) {
-            return el.second;
-    });
+    const ComponentRange components = _store.getComponents();
+
+    return ::std::vector<::std::shared_ptr<Component>>(components.begin(),
+                                                       components.end());
+}
+
+uint32_t Menu::getDenseIndex(const Component& component) const {
+    auto it = _handleOf.find(&component);
+
+    if (it == _handleOf.end())
+        return ComponentStore::INVALID_INDEX;
 
-    return temp;
+    return _store.getDenseIndex(it->second);
+}
+
+void Menu::setHovered(const Component& component, const bool& hovered) {
+    const uint32_t dense = getDenseIndex(component);
+
+    if (dense != ComponentStore::INVALID_INDEX)
+        _store.setFlags(dense, HOVERED, hovered);
+}
+
+bool Menu::isHovered(const Component& component) const {
+    const uint32_t dense = getDenseIndex(component);
+
+    return dense != ComponentStore::INVALID_INDEX &&
+           (_store.getFlags(dense) & HOVERED);
+}
+
+void Menu::updateHover(const Point& point) {
+    const ComponentRange hits = getComponentsAt(point);
+
+    if (hits.size() == _hovered.size() &&
+        ::std::equal(hits.begin(), hits.end(), _hovered.begin()))
+        return;
+
+    ::std::vector<::std::shared_ptr<Component>> previous =
+        ::std::move(_hovered);
+    ::std::vector<::std::shared_ptr<Component>> entered;
+
+    _hovered.assign(hits.begin(), hits.end());
+
+    // The flags still describe the previous state at this point
+    for (const auto& component : _hovered) {
+        if (!isHovered(*component))
+            entered.push_back(component);
+    }
+
+    for (const auto& component : previous)
+        setHovered(*component, false);
+
+    for (const auto& component : _hovered)
+        setHovered(*component, true);
+
+    // Only the components that lost their flag were left
+    previous.erase(::std::remove_if(previous.begin(), previous.end(),
+        [this](const ::std::shared_ptr<Component>& component) {
+            return isHovered(*component);
+    }), previous.end());
+
+    for (const auto& component : previous)
+        component->onHoverLeave();
+
+    for (const auto& component : entered)
+        component->onHoverEnter();
+}
+
+void Menu::clearHover() {
+    ::std::vector<::std::shared_ptr<Component>> previous =
+        ::std::move(_hovered);
+
+    _hovered.clear();
+
+    for (const auto& component : previous)
+        setHovered(*component, false);
+
+    for (const auto& component : previous)
+        component->onHoverLeave();
 }
 
 void Menu::clear() {
-    _components.clear();
+    for (const auto& component : _store.getComponents())
+        component->removeObserver(this);
+
+    // Dropping the scope first leaves nothing for the elements to unbind
+    AlignmentTool::getInstance().clearScope(_bindingScope);
+
+    _index.clear();
+    _store.clear();
+    _handleOf.clear();
+    _grid.clear();
+    _hovered.clear();
+    _drawOrder.clear();
+    _drawRank.clear();
+
+    _dispatcher.clear();
+    invalidateDrawList();
+}
+
+void Menu::setStaticDispatch(const bool& enabled) {
+    _staticDispatch = enabled;
+    _dispatchValid = false;
+
+    if (!enabled)
+        _dispatcher.clear();
+}
+
+bool Menu::isStaticDispatch() const {
+    return _staticDispatch;
+}
+
+void Menu::setBatching(const bool& enabled) {
+    _batching = enabled;
+    _renderer.invalidate();
+    _dirty = true;
+}
+
+bool Menu::isBatching() const {
+    return _batching;
+}
+
+size_t Menu::getBatchCount() const {
+    return _renderer.getBatchCount();
+}
+
+void Menu::setCaching(const bool& enabled) {
+    _caching = enabled;
+    _cached.clear();
+    _live.clear();
+
+    if (enabled)
+        _cache.invalidate();
+    else
+        _cache.release();
+
+    _dirty = true;
+}
+
+bool Menu::isCaching() const {
+    return _caching;
+}
+
+void Menu::setCulling(const bool& enabled) {
+    _culling = enabled;
+    _dirty = true;
+}
+
+bool Menu::isCulling() const {
+    return _culling;
+}
+
+bool Menu::setDynamic(const ComponentHandle& handle, const bool& dynamic) {
+    const uint32_t dense = _store.getDenseIndex(handle);
+
+    if (dense == ComponentStore::INVALID_INDEX)
+        return false;
+
+    _store.setFlags(dense, DYNAMIC, dynamic);
+    _cache.invalidate();
+    _dirty = true;
+
+    return true;
+}
+
+bool Menu::setDynamic(const ::std::string_view ID, const bool& dynamic) {
+    return setDynamic(getHandle(ID), dynamic);
+}
+
+bool Menu::setLayer(const ComponentHandle& handle, const int32_t layer) {
+    const uint32_t dense = _store.getDenseIndex(handle);
+
+    if (dense == ComponentStore::INVALID_INDEX)
+        return false;
+
+    if (_store.getLayer(dense) == layer)
+        return true;
+
+    const size_t position = _drawRank[dense];
+
+    _drawOrder.erase(_drawOrder.begin() + static_cast<ptrdiff_t>(position));
+    _store.setLayer(dense, layer);
+
+    const size_t inserted = insertDrawOrder(dense);
+
+    updateDrawRanks(::std::min(position, inserted));
+    invalidateDrawList();
+
+    return true;
+}
+
+int32_t Menu::getLayer(const ComponentHandle& handle) const {
+    const uint32_t dense = _store.getDenseIndex(handle);
+
+    if (dense == ComponentStore::INVALID_INDEX)
+        return 0;
+
+    return _store.getLayer(dense);
+}
+
+bool Menu::setVisible(const ComponentHandle& handle, const bool& visible) {
+    const uint32_t dense = _store.getDenseIndex(handle);
+
+    if (dense == ComponentStore::INVALID_INDEX)
+        return false;
+
+    if (!(_store.getFlags(dense) & HIDDEN) == visible)
+        return true;
+
+    _store.setFlags(dense, HIDDEN, !visible);
+
+    if (!visible)
+        stopHover(dense);
+
+    invalidateDrawList();
+
+    return true;
+}
+
+bool Menu::isVisible(const ComponentHandle& handle) const {
+    const uint32_t dense = _store.getDenseIndex(handle);
+
+    return dense != ComponentStore::INVALID_INDEX &&
+           !(_store.getFlags(dense) & HIDDEN);
+}
+
+bool Menu::setEnabled(const ComponentHandle& handle, const bool& enabled) {
+    const uint32_t dense = _store.getDenseIndex(handle);
+
+    if (dense == ComponentStore::INVALID_INDEX)
+        return false;
+
+    _store.setFlags(dense, DISABLED, !enabled);
+
+    if (!enabled)
+        stopHover(dense);
+
+    return true;
+}
+
+bool Menu::isEnabled(const ComponentHandle& handle) const {
+    const uint32_t dense = _store.getDenseIndex(handle);
+
+    return dense != ComponentStore::INVALID_INDEX &&
+           !(_store.getFlags(dense) & DISABLED);
+}
+
+void Menu::stopHover(const uint32_t dense) {
+    if (!(_store.getFlags(dense) & HOVERED))
+        return;
+
+    const ::std::shared_ptr<Component> component = _store.getComponent(dense);
+
+    _store.setFlags(dense, HOVERED, false);
+    _hovered.erase(::std::remove(_hovered.begin(), _hovered.end(), component),
+                   _hovered.end());
+
+    component->onHoverLeave();
+}
+
+bool Menu::precedes(const uint32_t first, const uint32_t second) const {
+    const int32_t firstLayer = _store.getLayer(first);
+    const int32_t secondLayer = _store.getLayer(second);
+
+    // Within a layer, components keep the order they were added in
+    if (firstLayer != secondLayer)
+        return firstLayer < secondLayer;
+
+    return first < second;
+}
+
+size_t Menu::insertDrawOrder(const uint32_t dense) {
+    auto it = ::std::upper_bound(_drawOrder.begin(), _drawOrder.end(), dense,
+        [this](const uint32_t first, const uint32_t second) {
+            return precedes(first, second);
+    });
+
+    const size_t position = static_cast<size_t>(it - _drawOrder.begin());
+
+    _drawOrder.insert(it, dense);
+    updateDrawRanks(position);
+
+    return position;
+}
+
+void Menu::eraseDrawOrder(const uint32_t dense) {
+    const size_t position = _drawRank[dense];
+
+    _drawOrder.erase(_drawOrder.begin() + static_cast<ptrdiff_t>(position));
+
+    // The store shifts the components after the erased one
+    for (uint32_t& other : _drawOrder) {
+        if (other > dense)
+            --other;
+    }
+
+    updateDrawRanks(0);
+}
+
+void Menu::updateDrawRanks(const size_t first) {
+    _drawRank.resize(_drawOrder.size());
+
+    for (size_t i = first; i < _drawOrder.size(); ++i)
+        _drawRank[_drawOrder[i]] = static_cast<uint32_t>(i);
+}
+
+void Menu::invalidateDrawList() {
+    _drawListValid = false;
+    _dispatchValid = false;
+    _renderer.invalidate();
+    _cache.invalidate();
+    _dirty = true;
+}
+
+ComponentRange Menu::getDrawList() const {
+    if (!_drawListValid) {
+        _drawList.clear();
+
+        for (const uint32_t dense : _drawOrder) {
+            if (!(_store.getFlags(dense) & HIDDEN))
+                _drawList.push_back(_store.getComponent(dense));
+        }
+
+        _drawListValid = true;
+    }
+
+    return ComponentRange(_drawList.data(),
+                          _drawList.data() + _drawList.size());
+}
+
+void Menu::markDirty() {
+    _dirty = true;
+}
+
+bool Menu::isDirty() const {
+    return _dirty;
+}
+
+BindingScope Menu::getBindingScope() const {
+    return _bindingScope;
+}
+
+void Menu::clearDirty() {
+    _dirty = false;
+
+    for (const auto& component : _store.getComponents())
+        component->clearDirty();
 }
 
 void Menu::setContainer(const WindowPtr& container) {
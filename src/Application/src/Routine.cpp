@@ -52,13 +52,29 @@ Routine::Routine(bool (*trigger)(const ::sf::Event&),
     _isActive = true;
 }
 
+Routine::Routine(bool (*trigger)(const ::sf::Event&),
+                 const ::std::shared_ptr<Task>& action,
+                 const ::std::vector<::sf::Event::EventType>& eventTypes) :
+    Routine(trigger, action) {
+    for (const ::sf::Event::EventType& type : eventTypes) {
+        if (type >= ::sf::Event::Count)
+            throw ApplicationException("Invalid event type for routine.");
+    }
+
+    _eventTypes = eventTypes;
+}
+
+const ::std::vector<::sf::Event::EventType>& Routine::getEventTypes() const {
+    return _eventTypes;
+}
+
 void Routine::setActive(const bool& active) {
     _isActive = active;
 }
 
 void Routine::operator()(const ::sf::Event &event) const {
     if (_isActive && _trigger(event))
-        _action->exec();
+        TaskScheduler::run(_action);
 }
 
 }  // namespace easyGUI
@@ -0,0 +1,211 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file SpatialGrid.cpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Implementation of the SpatialGrid class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <SpatialGrid.hpp>
+
+
+namespace easyGUI {
+
+// Elements covering more cells than this are not stored in the cells
+static const int64_t MAX_CELLS_PER_ELEMENT = 256;
+
+// Keeps cell coordinates far away from the limits of int32_t
+static const float MAX_CELL_COORD = 1e9f;
+
+SpatialGrid::SpatialGrid(const float& cellSize) :
+    _cellSize(cellSize > 0 ? cellSize : 64.0f) {
+    resetExtent();
+}
+
+bool SpatialGrid::CellRange::isOversized() const noexcept {
+    const int64_t columns = static_cast<int64_t>(maxX) - minX + 1;
+    const int64_t rows = static_cast<int64_t>(maxY) - minY + 1;
+
+    return columns * rows > MAX_CELLS_PER_ELEMENT;
+}
+
+int32_t SpatialGrid::toCell(const float& position) const noexcept {
+    const float cell = ::std::floor(position / _cellSize);
+
+    return static_cast<int32_t>(
+        ::std::max(-MAX_CELL_COORD, ::std::min(MAX_CELL_COORD, cell)));
+}
+
+int64_t SpatialGrid::getKey(const int32_t x, const int32_t y) noexcept {
+    return (static_cast<int64_t>(x) << 32) |
+           static_cast<int64_t>(static_cast<uint32_t>(y));
+}
+
+void SpatialGrid::resetExtent() noexcept {
+    _extent.minX = ::std::numeric_limits<int32_t>::max();
+    _extent.minY = ::std::numeric_limits<int32_t>::max();
+    _extent.maxX = ::std::numeric_limits<int32_t>::min();
+    _extent.maxY = ::std::numeric_limits<int32_t>::min();
+}
+
+SpatialGrid::CellRange SpatialGrid::getRange(
+        const ::sf::FloatRect& bounds) const noexcept {
+    CellRange range;
+
+    range.minX = toCell(bounds.left);
+    range.minY = toCell(bounds.top);
+    range.maxX = toCell(bounds.left + bounds.width);
+    range.maxY = toCell(bounds.top + bounds.height);
+
+    return range;
+}
+
+void SpatialGrid::erase(::std::vector<uint32_t>& list, const uint32_t index) {
+    auto it = ::std::find(list.begin(), list.end(), index);
+
+    if (it != list.end()) {
+        *it = list.back();
+        list.pop_back();
+    }
+}
+
+void SpatialGrid::insert(const uint32_t index,
+                         const ::sf::FloatRect& bounds) {
+    const CellRange range = getRange(bounds);
+
+    if (range.isOversized()) {
+        _oversized.push_back(index);
+        return;
+    }
+
+    for (int32_t x = range.minX; x <= range.maxX; ++x) {
+        for (int32_t y = range.minY; y <= range.maxY; ++y)
+            _cells[getKey(x, y)].push_back(index);
+    }
+
+    _extent.minX = ::std::min(_extent.minX, range.minX);
+    _extent.minY = ::std::min(_extent.minY, range.minY);
+    _extent.maxX = ::std::max(_extent.maxX, range.maxX);
+    _extent.maxY = ::std::max(_extent.maxY, range.maxY);
+}
+
+void SpatialGrid::remove(const uint32_t index,
+                         const ::sf::FloatRect& bounds) {
+    const CellRange range = getRange(bounds);
+
+    if (range.isOversized()) {
+        erase(_oversized, index);
+        return;
+    }
+
+    for (int32_t x = range.minX; x <= range.maxX; ++x) {
+        for (int32_t y = range.minY; y <= range.maxY; ++y) {
+            auto cell = _cells.find(getKey(x, y));
+
+            if (cell == _cells.end())
+                continue;
+
+            erase(cell->second, index);
+
+            if (cell->second.empty())
+                _cells.erase(cell);
+        }
+    }
+
+    if (_cells.empty())
+        resetExtent();
+}
+
+void SpatialGrid::update(const uint32_t index,
+                         const ::sf::FloatRect& oldBounds,
+                         const ::sf::FloatRect& newBounds) {
+    remove(index, oldBounds);
+    insert(index, newBounds);
+}
+
+void SpatialGrid::query(const Point& point,
+                        ::std::vector<uint32_t>& result) const {
+    auto cell = _cells.find(getKey(toCell(point.Xcoord),
+                                   toCell(point.Ycoord)));
+
+    if (cell != _cells.end())
+        result.insert(result.end(), cell->second.begin(), cell->second.end());
+
+    result.insert(result.end(), _oversized.begin(), _oversized.end());
+}
+
+void SpatialGrid::query(const ::sf::FloatRect& bounds,
+                        ::std::vector<uint32_t>& result) const {
+    CellRange range = getRange(bounds);
+
+    // Cells outside the populated extent are empty
+    range.minX = ::std::max(range.minX, _extent.minX);
+    range.minY = ::std::max(range.minY, _extent.minY);
+    range.maxX = ::std::min(range.maxX, _extent.maxX);
+    range.maxY = ::std::min(range.maxY, _extent.maxY);
+
+    if (range.minX <= range.maxX && range.minY <= range.maxY) {
+        const int64_t columns = static_cast<int64_t>(range.maxX) -
+                                range.minX + 1;
+        const int64_t rows = static_cast<int64_t>(range.maxY) - range.minY + 1;
+
+        if (columns * rows > static_cast<int64_t>(_cells.size())) {
+            // Fewer populated cells than cells in the area
+            for (const auto& cell : _cells) {
+                const int32_t x = static_cast<int32_t>(cell.first >> 32);
+                const int32_t y = static_cast<int32_t>(
+                    static_cast<uint32_t>(cell.first));
+
+                if (x >= range.minX && x <= range.maxX &&
+                    y >= range.minY && y <= range.maxY)
+                    result.insert(result.end(), cell.second.begin(),
+                                  cell.second.end());
+            }
+        } else {
+            for (int32_t x = range.minX; x <= range.maxX; ++x) {
+                for (int32_t y = range.minY; y <= range.maxY; ++y) {
+                    auto cell = _cells.find(getKey(x, y));
+
+                    if (cell != _cells.end())
+                        result.insert(result.end(), cell->second.begin(),
+                                      cell->second.end());
+                }
+            }
+        }
+    }
+
+    result.insert(result.end(), _oversized.begin(), _oversized.end());
+}
+
+void SpatialGrid::clear() {
+    _cells.clear();
+    _oversized.clear();
+    resetExtent();
+}
+
+}  // namespace easyGUI
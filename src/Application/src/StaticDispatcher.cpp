@@ -0,0 +1,163 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file StaticDispatcher.cpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Implementation of the StaticDispatcher class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#include <StaticDispatcher.hpp>
+
+
+namespace easyGUI {
+
+template <class T>
+void StaticDispatcher::append(::std::vector<const T*>& group,
+                              const Component* component,
+                              const TypeTag tag) {
+    const uint32_t index = static_cast<uint32_t>(group.size());
+
+    group.push_back(static_cast<const T*>(component));
+
+    if (!_runs.empty() && _runs.back().tag == tag)
+        ++_runs.back().count;
+    else
+        _runs.push_back(Run{tag, index, 1});
+}
+
+template <class T>
+void StaticDispatcher::drawRun(const ::std::vector<const T*>& group,
+                               const Run& run,
+                               ::sf::RenderTarget& target,
+                               const ::sf::RenderStates& states) {
+    const uint32_t last = run.first + run.count;
+
+    // The qualified call is resolved at compile time
+    for (uint32_t i = run.first; i < last; ++i)
+        group[i]->T::draw(target, states);
+}
+
+void StaticDispatcher::rebuild(const ComponentRange& components) {
+    clear();
+
+    for (const auto& component : components) {
+        const Component* pointer = component.get();
+
+        // Subclasses of the built-in types may override draw, so only the
+        // exact types are drawn through the qualified calls
+        switch (pointer->getTypeTag()) {
+            case TAG_BUTTON:
+                if (pointer->isExactly<Button>()) {
+                    append(_buttons, pointer, TAG_BUTTON);
+                    continue;
+                }
+                break;
+            case TAG_LABEL:
+                if (pointer->isExactly<Label>()) {
+                    append(_labels, pointer, TAG_LABEL);
+                    continue;
+                }
+                break;
+            case TAG_TEXTBOX:
+                if (pointer->isExactly<TextBox>()) {
+                    append(_textBoxes, pointer, TAG_TEXTBOX);
+                    continue;
+                }
+                break;
+            case TAG_PASSWORDBOX:
+                // Password boxes are drawn as text boxes
+                if (pointer->isExactly<PasswordBox>()) {
+                    append(_textBoxes, pointer, TAG_TEXTBOX);
+                    continue;
+                }
+                break;
+            case TAG_IMAGE:
+                if (pointer->isExactly<Image>()) {
+                    append(_images, pointer, TAG_IMAGE);
+                    continue;
+                }
+                break;
+            case TAG_CHECKBOX:
+                if (pointer->isExactly<CheckBox>()) {
+                    append(_checkBoxes, pointer, TAG_CHECKBOX);
+                    continue;
+                }
+                break;
+            case TAG_SEPARATOR:
+                if (pointer->isExactly<Separator>()) {
+                    append(_separators, pointer, TAG_SEPARATOR);
+                    continue;
+                }
+                break;
+            default:
+                break;
+        }
+
+        append(_others, pointer, TAG_NONE);
+    }
+}
+
+void StaticDispatcher::clear() {
+    _runs.clear();
+    _buttons.clear();
+    _labels.clear();
+    _textBoxes.clear();
+    _images.clear();
+    _checkBoxes.clear();
+    _separators.clear();
+    _others.clear();
+}
+
+void StaticDispatcher::draw(::sf::RenderTarget& target,
+                            ::sf::RenderStates states) const {
+    for (const Run& run : _runs) {
+        switch (run.tag) {
+            case TAG_BUTTON:
+                drawRun(_buttons, run, target, states);
+                break;
+            case TAG_LABEL:
+                drawRun(_labels, run, target, states);
+                break;
+            case TAG_TEXTBOX:
+                drawRun(_textBoxes, run, target, states);
+                break;
+            case TAG_IMAGE:
+                drawRun(_images, run, target, states);
+                break;
+            case TAG_CHECKBOX:
+                drawRun(_checkBoxes, run, target, states);
+                break;
+            case TAG_SEPARATOR:
+                drawRun(_separators, run, target, states);
+                break;
+            default:
+                // User components are drawn through the virtual call
+                for (uint32_t i = run.first; i < run.first + run.count; ++i)
+                    target.draw(*_others[i], states);
+                break;
+        }
+    }
+}
+
+}  // namespace easyGUI
@@ -0,0 +1,133 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file TimerQueue.cpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Implementation of the TimerQueue class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#include <algorithm>
+#include <functional>
+
+#include <Exceptions/ApplicationException.hpp>
+#include <TimerQueue.hpp>
+
+
+namespace easyGUI {
+
+// Shortest period of a repeating timer, in microseconds
+static const int64_t MIN_PERIOD = 1000;
+
+bool TimerQueue::Timer::operator> (const Timer& other) const noexcept {
+    return deadline > other.deadline;
+}
+
+int64_t TimerQueue::now() const {
+    return _clock.getElapsedTime().asMicroseconds();
+}
+
+uint32_t TimerQueue::add(const ::std::shared_ptr<Task>& task,
+                         const ::sf::Time& delay,
+                         const bool& repeat) {
+    if (task == nullptr)
+        throw ApplicationException("Attempting to schedule an empty task.");
+
+    const int64_t offset = ::std::max<int64_t>(0, delay.asMicroseconds());
+
+    Timer timer;
+    timer.deadline = now() + offset;
+    timer.period = repeat ? ::std::max(MIN_PERIOD, offset) : 0;
+    timer.id = _nextId++;
+    timer.task = task;
+
+    _heap.push_back(timer);
+    ::std::push_heap(_heap.begin(), _heap.end(), ::std::greater<Timer>());
+    _active.insert(timer.id);
+
+    return timer.id;
+}
+
+void TimerQueue::remove(const uint32_t id) {
+    _active.erase(id);
+}
+
+void TimerQueue::discardRemoved() {
+    while (!_heap.empty() && _active.count(_heap.front().id) == 0) {
+        ::std::pop_heap(_heap.begin(), _heap.end(), ::std::greater<Timer>());
+        _heap.pop_back();
+    }
+}
+
+bool TimerQueue::runDue() {
+    const int64_t current = now();
+    bool ran = false;
+
+    discardRemoved();
+
+    while (!_heap.empty() && _heap.front().deadline <= current) {
+        ::std::pop_heap(_heap.begin(), _heap.end(), ::std::greater<Timer>());
+        Timer timer = _heap.back();
+        _heap.pop_back();
+
+        if (timer.period == 0) {
+            _active.erase(timer.id);
+        } else {
+            // Re-armed first, so that a throwing task keeps its timer
+            Timer next = timer;
+            next.deadline += next.period;
+
+            if (next.deadline <= current)
+                next.deadline = current + next.period;
+
+            _heap.push_back(next);
+            ::std::push_heap(_heap.begin(), _heap.end(),
+                             ::std::greater<Timer>());
+        }
+
+        ran = true;
+
+        // The task may cancel its own timer, which is then discarded
+        TaskScheduler::run(timer.task);
+
+        discardRemoved();
+    }
+
+    return ran;
+}
+
+bool TimerQueue::empty() const {
+    return _active.empty();
+}
+
+::sf::Time TimerQueue::getTimeUntilNext() const {
+    // Removed timers may still be at the top, which only makes the caller
+    // wake up earlier than needed
+    if (_heap.empty())
+        return ::sf::Time::Zero;
+
+    return ::sf::microseconds(
+        ::std::max<int64_t>(0, _heap.front().deadline - now()));
+}
+
+}  // namespace easyGUI
@@ -34,10 +34,13 @@
     #include <assets-export.hpp>
 #endif
 
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+#include <map>
 #include <utility>
 #include <vector>
 #include <memory>
-#include <map>
 
 #include <Exceptions/AssetException.hpp>
 #include <Component.hpp>
@@ -76,8 +79,11 @@ class Anchor : public ::std::enable_shared_from_this<Anchor>
     /**
      * @brief Destructor
      * 
+     * @details Removes every binding and constraint the anchor takes part
+     * in, so neither the alignment tool nor the constraint layout ever hold
+     * a dangling anchor.
      */
-    virtual ~Anchor() = default;
+    virtual ~Anchor();
 
     /**
      * @brief Constructor
@@ -88,6 +94,9 @@ class Anchor : public ::std::enable_shared_from_this<Anchor>
     /**
      * @brief Returns a binding point of the anchor
      * 
+     * @details Built-in components derive their binding points from their
+     * cached bounds (see Component#getCachedBounds), so this is cheap.
+     * 
      * @param point Which point to return
      * 
      * @return Point The binding point
@@ -129,6 +138,24 @@ class Anchor : public ::std::enable_shared_from_this<Anchor>
      */
     virtual Point getCENTER() const = 0;
 
+    /**
+     * @brief Returns the component behind the anchor
+     * 
+     * @details The built-in components override this, so moving them does
+     * not need RTTI. By default, the component is found through a
+     * dynamic_cast. User anchors built without RTTI must override this
+     * method as well, or bindings will not move them.
+     * 
+     * @return Component* nullptr if the anchor is not a component
+     */
+    virtual Component* toComponent() {
+#if EASYGUI_RTTI
+        return dynamic_cast<Component*>(this);
+#else
+        return nullptr;
+#endif
+    }
+
     /**
      * @brief Converts the current pointer to an anchor
      * 
@@ -141,6 +168,47 @@ class Anchor : public ::std::enable_shared_from_this<Anchor>
 
 using AnchorPtr = ::std::shared_ptr<Anchor>;
 
+/**
+ * @brief Describes a binding, for creating many at once
+ * 
+ * @details See AlignmentTool#createBindings.
+ */
+struct BindingDescription {
+    Anchor* source = nullptr;
+    Anchor* anchor = nullptr;
+
+    BindingPoint sourcePoint = BindingPoint::CENTER;
+    BindingPoint anchorPoint = BindingPoint::CENTER;
+
+    Point offset;
+};
+
+/**
+ * @brief Identifies a group of bindings that are released together
+ * 
+ * @details Menus own a scope for the bindings created while their elements
+ * are added. Bindings created outside of any scope belong to GLOBAL_SCOPE.
+ */
+using BindingScope = uint32_t;
+
+constexpr BindingScope GLOBAL_SCOPE = 0;
+
+/**
+ * @brief Statistics about the live bindings
+ * 
+ * @details See AlignmentTool#getStats.
+ */
+struct BindingStats {
+    // Number of live bindings
+    size_t bindings = 0;
+
+    // Number of anchors that have elements bound to them
+    size_t anchors = 0;
+
+    // Number of scopes, including the global one
+    size_t scopes = 0;
+};
+
 /**
  * @brief Class responsible with computing positions
  * 
@@ -161,7 +229,7 @@ class AlignmentTool
      * @brief Destructor
      * 
      */
-    virtual ~AlignmentTool() = default;
+    virtual ~AlignmentTool();
 
     /**
      * @brief Returns an instance of the Alignment tool
@@ -170,6 +238,52 @@ class AlignmentTool
      */
     static AlignmentTool& getInstance();
 
+    /**
+     * @brief Returns the instance of the Alignment tool, if it still exists
+     * 
+     * @details Used by destructors that may run after the tool was
+     * destroyed at exit, which is why it never creates the instance.
+     * 
+     * @return AlignmentTool* nullptr if the tool does not exist
+     */
+    static AlignmentTool* getLiveInstance();
+
+    /**
+     * @brief Selects the scope of the bindings created from now on
+     * 
+     * @details Restores the previous scope when destroyed:
+     * 
+     * {
+     *     AlignmentTool::ScopeGuard guard(menu->getBindingScope());
+     *     // Bindings created here are released with the menu
+     * }
+     */
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+    class ASSETS_EXPORTS ScopeGuard
+#else
+    class ScopeGuard
+#endif
+    {
+     public:
+        /**
+         * @brief Constructor
+         * 
+         * @param scope The scope to be selected
+         */
+        explicit ScopeGuard(const BindingScope&);
+
+        /**
+         * @brief Destructor
+         * 
+         */
+        ~ScopeGuard();
+
+        ScopeGuard(const ScopeGuard&) = delete;
+        ScopeGuard& operator= (const ScopeGuard&) = delete;
+     private:
+        BindingScope _previous;
+    };
+
     /**
      * @brief Creates a binding between two elements
      * 
@@ -191,14 +305,122 @@ class AlignmentTool
                        const BindingPoint&,
                        const Point& = Point());
 
+    /**
+     * @brief Creates many bindings at once
+     * 
+     * @details The bound elements are only moved after all bindings are
+     * created, through a single solve, so every element is moved once.
+     * Invalid descriptions are reported and skipped; existing bindings are
+     * left unchanged.
+     * 
+     * @param bindings The bindings to be created
+     */
+    void createBindings(const ::std::vector<BindingDescription>&);
+
     /**
      * @brief Updates all the elements bound to an anchor
      * 
+     * @details Only the elements bound to the anchor are visited. They
+     * propagate the change to their own dependents when they move. In
+     * deferred mode, the anchor is only recorded until the next solve.
+     * 
      * @param source The anchor that moved
      */
     void triggerUpdate(const Anchor*);
 
     void triggerUpdate(const AnchorPtr&);
+
+    /**
+     * @brief Toggles deferred layout
+     * 
+     * @details In deferred mode, moving an anchor does not move the
+     * elements bound to it right away. All moves are resolved at once by
+     * solve, which the application calls before drawing each frame.
+     * Disabled by default.
+     * 
+     * @param deferred Whether updates are deferred
+     */
+    void setDeferred(const bool&);
+
+    /**
+     * @brief Checks if updates are deferred
+     * 
+     * @return true Updates wait for the next solve
+     * @return false Updates are applied immediately
+     */
+    bool isDeferred() const;
+
+    /**
+     * @brief Moves the elements bound to the anchors that moved
+     * 
+     * @details The affected elements are visited in topological order, so
+     * every element is moved exactly once, after all of its anchors.
+     * Elements bound in a cycle are reported and left in place.
+     * 
+     * @return size_t The number of elements left in place by cycles
+     */
+    size_t solve();
+
+    // ----- Binding lifetime -----
+
+    /**
+     * @brief Removes every binding an anchor takes part in
+     * 
+     * @details Called automatically when an anchor is destroyed. The
+     * elements bound to the anchor stay where they are.
+     * 
+     * @param anchor The anchor to be released
+     */
+    void unbind(const Anchor*);
+
+    /**
+     * @brief Creates an empty scope
+     * 
+     * @return BindingScope The new scope
+     */
+    BindingScope createScope();
+
+    /**
+     * @brief Selects the scope of the bindings created from now on
+     * 
+     * @details Prefer ScopeGuard, which restores the previous scope.
+     * 
+     * @param scope The scope to be selected
+     */
+    void setActiveScope(const BindingScope&);
+
+    /**
+     * @brief Returns the scope of the bindings created from now on
+     * 
+     * @return BindingScope
+     */
+    BindingScope getActiveScope() const;
+
+    /**
+     * @brief Removes all the bindings of a scope
+     * 
+     * @details Only the live bindings of the scope are visited. The scope
+     * can still be used afterwards.
+     * 
+     * @param scope The scope to be cleared
+     */
+    void clearScope(const BindingScope&);
+
+    /**
+     * @brief Removes a scope along with its bindings
+     * 
+     * @details The global scope is only cleared.
+     * 
+     * @param scope The scope to be released
+     */
+    void releaseScope(const BindingScope&);
+
+    /**
+     * @brief Returns statistics about the live bindings
+     * 
+     * @return BindingStats
+     */
+    BindingStats getStats() const;
  private:
     struct Binding {
         Anchor* anchors[2];
@@ -206,10 +428,135 @@ class AlignmentTool
 
         Point offset;
 
-        bool operator== (const Binding&) const noexcept;
+        // The component moved by the binding, resolved once
+        Component* target;
+    };
+
+    struct BindingKey {
+        const Anchor* source;
+        const Anchor* anchor;
+
+        bool operator== (const BindingKey&) const noexcept;
+    };
+
+    struct BindingKeyHash {
+        size_t operator() (const BindingKey&) const noexcept;
+    };
+
+    struct ScopeLink {
+        BindingScope scope = GLOBAL_SCOPE;
+
+        // The key of the binding, owned by _keys
+        const BindingKey* key = nullptr;
+
+        // Neighbours among the live bindings of the scope
+        ScopeLink* previous = nullptr;
+        ScopeLink* next = nullptr;
+    };
+
+    struct Scope {
+        // Live bindings of the scope, linked through their entries in _keys
+        ScopeLink* head = nullptr;
+    };
+
+    // Bindings grouped by the anchor the elements are bound to
+    ::std::unordered_map<const Anchor*, ::std::vector<Binding>> _dependents;
+
+    // Anchors grouped by the element bound to them
+    ::std::unordered_map<const Anchor*,
+                         ::std::vector<const Anchor*>> _anchors;
+
+    // The scope of every live binding
+    ::std::unordered_map<BindingKey, ScopeLink, BindingKeyHash> _keys;
+
+    ::std::map<BindingScope, Scope> _scopes = {{GLOBAL_SCOPE, Scope()}};
+
+    BindingScope _activeScope = GLOBAL_SCOPE;
+    BindingScope _nextScope = GLOBAL_SCOPE + 1;
+
+    /**
+     * @brief Calls a function for every binding to an anchor
+     * 
+     * @details The bindings are copied before the call, so the function
+     * may create new bindings.
+     * 
+     * @param anchor The anchor
+     * @param function Called with each binding
+     */
+    template <class Function>
+    void forEachDependent(const Anchor*, Function);
+
+    /**
+     * @brief Checks if any element is bound to an anchor
+     * 
+     * @param anchor The anchor
+     * 
+     * @return true At least one element is bound to the anchor
+     * @return false otherwise
+     */
+    bool hasDependents(const Anchor*) const;
+
+    /**
+     * @brief Removes a binding from the indexes
+     * 
+     * @details The binding must exist. Its key is left to the caller.
+     * 
+     * @param source The bound element
+     * @param anchor The anchor to which the source is bound
+     */
+    void eraseBinding(const Anchor*, const Anchor*);
+
+    /**
+     * @brief Removes the key of a binding and unlinks it from its scope
+     * 
+     * @param key The key of the binding
+     * 
+     * @return true The binding existed
+     * @return false otherwise
+     */
+    bool eraseKey(const BindingKey&);
+
+    /**
+     * @brief Stores a binding without moving anything
+     * 
+     * @param source The bound element
+     * @param anchor The anchor to which the source is bound
+     * @param sourcePoint The point by which the source is bound
+     * @param anchorPoint The point by which the anchor is bound
+     * @param offset The desired offset
+     * 
+     * @return true The binding was added
+     * @return false The elements were already bound
+     */
+    bool addBinding(Anchor*,
+                    Anchor*,
+                    const BindingPoint&,
+                    const BindingPoint&,
+                    const Point&);
+
+    // ----- Layout passes -----
+
+    struct Placement {
+        Component* target = nullptr;
+        Point location;
     };
 
-    ::std::vector<Binding> _bindings;
+    bool _deferred = false;
+    bool _solving = false;
+
+    ::std::unordered_set<const Anchor*> _pending;
+    ::std::unordered_set<const Anchor*> _moving;
+
+    ::std::unordered_map<const Anchor*, uint32_t> _inDegree;
+    ::std::unordered_map<const Anchor*, Placement> _placements;
+    ::std::vector<const Anchor*> _stack;
+
+    /**
+     * @brief Moves the elements bound to an anchor right away
+     * 
+     * @param source The anchor that moved
+     */
+    void propagate(const Anchor*);
 
     /**
      * @brief Computes the position of an element
@@ -224,7 +571,7 @@ class AlignmentTool
      * @brief Constructor
      * 
      */
-    AlignmentTool() = default;
+    AlignmentTool();
 };
 
 }  // namespace easyGUI
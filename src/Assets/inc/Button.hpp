@@ -52,9 +52,13 @@ namespace easyGUI {
  * Label class in order to draw and configure the button's text.
  */
 #if defined(_WIN32) && BUILD_SHARED_LIBRARIES
-class ASSETS_EXPORTS Button : public Component, public Anchor
+class ASSETS_EXPORTS Button
+    : public TaggedComponent<Button, Component, TAG_BUTTON>,
+      public Anchor
 #else
-class Button : public Component, public Anchor
+class Button
+    : public TaggedComponent<Button, Component, TAG_BUTTON>,
+      public Anchor
 #endif
 {
  public:
@@ -115,16 +119,6 @@ class Button : public Component, public Anchor
     Button( const Button& ) = delete;
     Button& operator= ( const Button& ) = delete;
 
-    // ----- Auxiliaries -----
-
-    /**
-     * @brief Check if mouse is over the button
-     * 
-     * @return true Mouse is over the label
-     * @return false otherwise
-     */
-    bool isMouseHover() const override;
-
     // ----- Getters -----
 
     /**
@@ -148,6 +142,22 @@ class Button : public Component, public Anchor
      */
     void updateLocation(const Point&) override;
 
+    /**
+     * @brief Returns the axis-aligned bounds of the component
+     * 
+     * @return ::sf::FloatRect
+     */
+    ::sf::FloatRect getBounds() const override;
+
+    /**
+     * @brief Describes what the component draws, for batching
+     * 
+     * @param geometry Where the primitives of the component are added
+     * 
+     * @return true
+     */
+    bool buildGeometry(Geometry&) const override;
+
     // ----- Inherited from Anchor -----
 
     Point getLEFT() const override;
@@ -155,10 +165,22 @@ class Button : public Component, public Anchor
     Point getBOTTOM() const override;
     Point getTOP() const override;
     Point getCENTER() const override;
+
+    /**
+     * @brief Returns the component behind the anchor
+     * 
+     * @return Component*
+     */
+    Component* toComponent() override {
+        return this;
+    }
  private:
     ::sf::RectangleShape _shape;
     ::std::shared_ptr<Label> _content;
 
+    // Calls draw directly, without virtual dispatch
+    friend class StaticDispatcher;
+
     void draw(::sf::RenderTarget&, ::sf::RenderStates) const override;
 
     // ----- Helper methods -----
@@ -47,9 +47,13 @@
 namespace easyGUI {
 
 #if defined(_WIN32) && BUILD_SHARED_LIBRARIES
-class ASSETS_EXPORTS CheckBox : public Component, public Anchor
+class ASSETS_EXPORTS CheckBox
+    : public TaggedComponent<CheckBox, Component, TAG_CHECKBOX>,
+      public Anchor
 #else
-class CheckBox : public Component, public Anchor
+class CheckBox
+    : public TaggedComponent<CheckBox, Component, TAG_CHECKBOX>,
+      public Anchor
 #endif
 {
  public:
@@ -89,16 +93,6 @@ class CheckBox : public Component, public Anchor
     CheckBox( const CheckBox& ) = delete;
     CheckBox& operator= ( const CheckBox& ) = delete;
 
-    // ----- Auxiliaries -----
-
-    /**
-     * @brief Check if mouse is over the button
-     * 
-     * @return true Mouse is over the label
-     * @return false otherwise
-     */
-    bool isMouseHover() const override;
-
     // ----- Getters -----
 
     /**
@@ -131,11 +125,29 @@ class CheckBox : public Component, public Anchor
      */
     void updateLocation(const Point&) override;
 
+    /**
+     * @brief Returns the axis-aligned bounds of the component
+     * 
+     * @return ::sf::FloatRect
+     */
+    ::sf::FloatRect getBounds() const override;
+
+    /**
+     * @brief Describes what the component draws, for batching
+     * 
+     * @param geometry Where the primitives of the component are added
+     * 
+     * @return true
+     */
+    bool buildGeometry(Geometry&) const override;
+
     /**
      * @brief Checks / Unchecks the checkbox
      * 
+     * @param point The position of the click in world coordinates
      */
-    void onClick() override;
+    void onClick(const Point&) override;
+    using Component::onClick;
 
     // ----- Inherited from Anchor -----
 
@@ -144,11 +156,23 @@ class CheckBox : public Component, public Anchor
     Point getBOTTOM() const override;
     Point getTOP() const override;
     Point getCENTER() const override;
+
+    /**
+     * @brief Returns the component behind the anchor
+     * 
+     * @return Component*
+     */
+    Component* toComponent() override {
+        return this;
+    }
  private:
     ::sf::RectangleShape _box, _filler;
 
     uint8_t _isChecked;
 
+    // Calls draw directly, without virtual dispatch
+    friend class StaticDispatcher;
+
     void draw(::sf::RenderTarget&, ::sf::RenderStates) const override;
 };
 
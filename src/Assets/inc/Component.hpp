@@ -34,19 +34,87 @@
     #include <assets-export.hpp>
 #endif
 
+#include <type_traits>
+#include <typeinfo>
+#include <cstdint>
+#include <utility>
 #include <memory>
+#include <vector>
 
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Window/Mouse.hpp>
 
 #include <Exceptions/AssetException.hpp>
+#include <Geometry.hpp>
 #include <Point.hpp>
 #include <Task.hpp>
 
 
+// Set when the compiler provides RTTI (see DISABLE_RTTI)
+#if defined(__cpp_rtti) || defined(__GXX_RTTI) || defined(_CPPRTTI)
+    #define EASYGUI_RTTI 1
+#else
+    #define EASYGUI_RTTI 0
+#endif
+
 namespace easyGUI {
 
+class Component;
+
+using TypeTag = uint32_t;
+
+/**
+ * @brief Type tags of the built-in components
+ * 
+ * @details User-defined components should use tags starting from
+ * TAG_USER, see TaggedComponent.
+ */
+enum ComponentTag : TypeTag {
+    TAG_NONE = 0,
+    TAG_BUTTON,
+    TAG_LABEL,
+    TAG_TEXTBOX,
+    TAG_PASSWORDBOX,
+    TAG_IMAGE,
+    TAG_CHECKBOX,
+    TAG_SEPARATOR,
+    TAG_USER = 1024
+};
+
+/**
+ * @brief Interface for objects that track changes of components
+ * 
+ * @details Containers (such as menus) implement this interface in order to
+ * keep their internal indexes in sync with the components they hold.
+ */
+class ComponentObserver {
+ public:
+    /**
+     * @brief Destructor
+     * 
+     */
+    virtual ~ComponentObserver() = default;
+
+    /**
+     * @brief Called whenever a component's geometry or content changes
+     * 
+     * @param component The component that changed
+     */
+    virtual void onComponentUpdate(Component&) = 0;
+
+    /**
+     * @brief Called when a component being observed is destroyed
+     * 
+     * @details Observers which outlive their components use this to drop
+     * any reference to them.
+     * 
+     * @param component The component being destroyed
+     */
+    virtual void onComponentDestroyed(Component&) {}
+};
+
 /**
  * @brief Interface for drawable elements
  * 
@@ -67,7 +135,7 @@ class Component : public ::sf::Drawable
      * @brief Destructor
      * 
      */
-    virtual ~Component() = default;
+    virtual ~Component();
 
     /**
      * @brief Set the Component's container
@@ -79,12 +147,29 @@ class Component : public ::sf::Drawable
     // ----- Interaction methods -----
 
     /**
-     * @brief Check if mouse is over the button
+     * @brief Check if mouse is over the component
+     * 
+     * @details While a click is dispatched (see onClick), the position of
+     * the click is used. Otherwise, queries the current position of the
+     * mouse. Components without bounds are never hovered unless this method
+     * is overridden.
+     * 
+     * @return true Mouse is over the component
+     * @return false otherwise
+     */
+    virtual bool isMouseHover() const;
+
+    /**
+     * @brief Check if a point is over the component
      * 
-     * @return true Mouse is over the label
+     * @details Components without bounds forward to isMouseHover().
+     * 
+     * @param point The point in world coordinates
+     * 
+     * @return true The point is inside the component's bounds
      * @return false otherwise
      */
-    virtual bool isMouseHover() const = 0;
+    virtual bool isMouseHover(const Point&) const;
 
     /**
      * @brief Makes the component interactable
@@ -110,35 +195,244 @@ class Component : public ::sf::Drawable
     virtual void setOnHoverAction(void (*)());
 
     /**
-     * @brief Makes the component interactable
+     * @brief Sets the behaviour when the mouse enters the component
      * 
-     * @param action The task to be executed when component is clicked.
+     * @param action The task to be executed.
      */
     void setOnHoverAction(const std::shared_ptr<Task>&);
 
+    /**
+     * @brief Sets the behaviour when the mouse leaves the component
+     * 
+     * @param action The task to be executed.
+     */
+    void setOnHoverLeaveAction(const std::shared_ptr<Task>&);
+
     /**
      * @brief Executes the onClick action
      * 
+     * @details Runs the action if isMouseHover() is true. Called directly,
+     * dispatches a click at the current position of the mouse. Overriding
+     * this method still works when clicks carry their coordinates.
      */
     virtual void onClick();
 
+    /**
+     * @brief Executes the onClick action
+     * 
+     * @details Forwards to onClick(), during which isMouseHover() uses the
+     * position of the click instead of querying the mouse.
+     * 
+     * @param point The position of the click in world coordinates
+     */
+    virtual void onClick(const Point&);
+
     /**
      * @brief Executes the onHover action
      * 
      */
     virtual void onHover();
 
+    /**
+     * @brief Called when the mouse starts hovering the component
+     * 
+     * @details Executes the onHover action.
+     */
+    virtual void onHoverEnter();
+
+    /**
+     * @brief Called when the mouse stops hovering the component
+     * 
+     */
+    virtual void onHoverLeave();
+
     /**
      * @brief Updates a component's location
      * 
      * @param newLocation The new location of the component
      */
     virtual void updateLocation(const Point&) = 0;
+
+    /**
+     * @brief Returns the axis-aligned bounds of the component
+     * 
+     * @details The bounds are expressed in world coordinates and are used
+     * for hit testing. Components that do not override this method have no
+     * bounds (see hasBounds): they are never culled, and hit testing asks
+     * them through isMouseHover.
+     * 
+     * @return ::sf::FloatRect
+     */
+    virtual ::sf::FloatRect getBounds() const;
+
+    /**
+     * @brief Returns the bounds of the component, computed once per change
+     * 
+     * @details The result of getBounds is kept until markDirty is called,
+     * so repeated queries (hit testing, binding points) cost nothing.
+     * 
+     * @return const ::sf::FloatRect&
+     */
+    const ::sf::FloatRect& getCachedBounds() const;
+
+    /**
+     * @brief Checks if the component reports its bounds
+     * 
+     * @return true The component overrides getBounds
+     * @return false otherwise
+     */
+    bool hasBounds() const;
+
+    /**
+     * @brief Returns the area the component may cover
+     * 
+     * @details Same as getCachedBounds for components that have bounds.
+     * Components without bounds may cover any point, so their area is
+     * unbounded. Used for spatial indexing and culling.
+     * 
+     * @return ::sf::FloatRect
+     */
+    ::sf::FloatRect getExtent() const;
+
+    /**
+     * @brief Describes what the component draws, for batching
+     * 
+     * @details Menus that batch their draw calls use this instead of draw.
+     * Components that do not override it are drawn on their own. The
+     * built-in components only describe their exact type (see isExactly),
+     * so subclasses are drawn on their own unless they override this too.
+     * 
+     * @param geometry Where the primitives of the component are added
+     * 
+     * @return true The geometry describes the component
+     * @return false The component cannot be batched
+     */
+    virtual bool buildGeometry(Geometry&) const;
+
+    // ----- Change tracking -----
+
+    /**
+     * @brief Registers an observer that is notified of changes
+     * 
+     * @param observer The observer to be added
+     */
+    void addObserver(ComponentObserver*);
+
+    /**
+     * @brief Unregisters an observer
+     * 
+     * @param observer The observer to be removed
+     */
+    void removeObserver(ComponentObserver*);
+
+    /**
+     * @brief Flags the component as needing to be redrawn
+     * 
+     * @details Built-in components call this whenever their geometry or
+     * content changes, which also drops the cached bounds and notifies all
+     * registered observers. If you alter a component through one of its
+     * internal getters (e.g. getInternalText), call this method afterwards
+     * so that applications running in on-demand redraw mode present the
+     * change.
+     */
+    void markDirty();
+
+    /**
+     * @brief Checks if the component changed since the last frame
+     * 
+     * @return true The component needs to be redrawn
+     * @return false otherwise
+     */
+    bool isDirty() const;
+
+    /**
+     * @brief Marks the component as being up to date on screen
+     * 
+     */
+    void clearDirty();
+
+    // ----- Type information -----
+
+    /**
+     * @brief Returns the type tag of the most derived registered type
+     * 
+     * @return TypeTag
+     */
+    TypeTag getTypeTag() const {
+        return _typeTag;
+    }
+
+    /**
+     * @brief Checks if the component is of a registered type
+     * 
+     * @details Exact matches cost a single comparison. Base types (e.g.
+     * TextBox for a PasswordBox) are resolved through isKindOf.
+     * 
+     * @tparam T A type registered through TaggedComponent
+     * 
+     * @return true The component is a T
+     * @return false otherwise
+     */
+    template <class T> bool is() const {
+        static_assert(::std::is_same<typename T::TaggedType, T>::value,
+                      "The type must be registered through TaggedComponent");
+
+        return _typeTag == T::TYPE_TAG || isKindOf(T::TYPE_TAG);
+    }
+
+    /**
+     * @brief Checks if the component is a T, and not a subclass of it
+     * 
+     * @details Used to call the methods of T directly (e.g. T::draw)
+     * without skipping the overrides of a subclass. With RTTI, this rejects
+     * every subclass. Without it, only the type tag is compared, so
+     * subclasses must register a tag of their own (see TaggedComponent).
+     * 
+     * @tparam T A type registered through TaggedComponent
+     * 
+     * @return true The dynamic type of the component is T
+     * @return false otherwise
+     */
+    template <class T> bool isExactly() const {
+        static_assert(::std::is_same<typename T::TaggedType, T>::value,
+                      "The type must be registered through TaggedComponent");
+
+#if EASYGUI_RTTI
+        return _typeTag == T::TYPE_TAG && typeid(*this) == typeid(T);
+#else
+        return _typeTag == T::TYPE_TAG;
+#endif
+    }
+
+    /**
+     * @brief Checks if the component derives from a tagged type
+     * 
+     * @param tag The tag of the type
+     * 
+     * @return true The component derives from the type
+     * @return false otherwise
+     */
+    virtual bool isKindOf(const TypeTag&) const {
+        return false;
+    }
  protected:
     ::std::shared_ptr<::sf::RenderWindow> _container;
 
+    const Point* _clickPoint = nullptr;
+
+    TypeTag _typeTag = TAG_NONE;
+
+    bool _dirty = true;
+
+    mutable ::sf::FloatRect _bounds;
+    mutable bool _boundsValid = false;
+    mutable bool _hasBounds = true;
+
+    ::std::vector<ComponentObserver*> _observers;
+
     ::std::shared_ptr<Task> _onClick = nullptr;
     ::std::shared_ptr<Task> _onHover = nullptr;
+    ::std::shared_ptr<Task> _onHoverLeave = nullptr;
 
     class DeprecatedTask : public Task {
      private:
@@ -154,4 +448,50 @@ class Component : public ::sf::Drawable
     };
 };
 
+/**
+ * @brief Registers a component type
+ * 
+ * @details Components derive from this template instead of deriving from
+ * their base directly, which gives them a type tag that can be checked
+ * without RTTI. User-defined components pick a unique tag starting from
+ * TAG_USER:
+ * 
+ * class MyComponent : public TaggedComponent<MyComponent, Component,
+ *                                            TAG_USER + 1> { ... };
+ * 
+ * @tparam Derived The registered component
+ * @tparam Base The component it derives from
+ * @tparam Tag The tag of the registered component
+ */
+template <class Derived, class Base, TypeTag Tag>
+class TaggedComponent : public Base {
+ public:
+    using TaggedType = Derived;
+
+    static constexpr TypeTag TYPE_TAG = Tag;
+
+    /**
+     * @brief Constructor
+     * 
+     * @param args The arguments forwarded to the base component
+     */
+    template <class... Args>
+    explicit TaggedComponent(Args&&... args)
+        : Base(::std::forward<Args>(args)...) {
+        this->_typeTag = Tag;
+    }
+
+    /**
+     * @brief Checks if the component derives from a tagged type
+     * 
+     * @param tag The tag of the type
+     * 
+     * @return true The component derives from the type
+     * @return false otherwise
+     */
+    bool isKindOf(const TypeTag& tag) const override {
+        return tag == Tag || Base::isKindOf(tag);
+    }
+};
+
 }  // namespace easyGUI
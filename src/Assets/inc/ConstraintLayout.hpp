@@ -0,0 +1,359 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file ConstraintLayout.hpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Definition of the ConstraintLayout class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#pragma once
+
+// Including dependencies
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+    #include <assets-export.hpp>
+#endif
+
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+
+#include <Exceptions/AssetException.hpp>
+#include <ConstraintSolver.hpp>
+#include <AlignmentTool.hpp>
+#include <Component.hpp>
+#include <Point.hpp>
+
+
+namespace easyGUI {
+
+/**
+ * @brief Quantities of an anchor that can be constrained
+ * 
+ */
+enum LayoutAttribute {
+    ATTRIBUTE_LEFT,
+    ATTRIBUTE_RIGHT,
+    ATTRIBUTE_TOP,
+    ATTRIBUTE_BOTTOM,
+    ATTRIBUTE_CENTER_X,
+    ATTRIBUTE_CENTER_Y,
+    ATTRIBUTE_WIDTH,
+    ATTRIBUTE_HEIGHT
+};
+
+/**
+ * @brief Lays out elements through linear constraints
+ * 
+ * @details This class is a Singleton which extends the AlignmentTool with
+ * constraints over the binding points, widths and heights of anchors and
+ * of the window, each with a priority (see ConstraintSolver). Unlike
+ * bindings, constraints may relate any number of elements and may be
+ * inequalities, which makes responsive layouts possible:
+ * 
+ * ConstraintLayout& layout = ConstraintLayout::getInstance();
+ * 
+ * // The button stays 10 pixels away from the right edge of the window
+ * layout.addConstraint(layout.getExpression(button, ATTRIBUTE_RIGHT) -
+ *                      layout.getWindowExpression(ATTRIBUTE_RIGHT) + 10.0,
+ *                      EQUAL);
+ * 
+ * The widths and heights of the elements follow their bounds, so only
+ * their positions are decided by the layout. Positions along an axis that
+ * no constraint refers to are left alone. Positions the constraints leave
+ * undecided weakly stay where they were last measured. Anchors which are
+ * not components are never moved. The application resolves the layout once
+ * per frame and whenever the window is resized, each change only updating
+ * the part of the solution that depends on it.
+ * 
+ * The layout observes the components it lays out, so that only those which
+ * changed are measured again and only those whose solution changed are
+ * moved.
+ */
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+class ASSETS_EXPORTS ConstraintLayout : public ComponentObserver
+#else
+class ConstraintLayout : public ComponentObserver
+#endif
+{
+ public:
+    /**
+     * @brief Destructor
+     * 
+     */
+    virtual ~ConstraintLayout();
+
+    /**
+     * @brief Returns an instance of the ConstraintLayout
+     * 
+     * @return ConstraintLayout&
+     */
+    static ConstraintLayout& getInstance();
+
+    /**
+     * @brief Returns the instance of the ConstraintLayout, if it still exists
+     * 
+     * @details See AlignmentTool#getLiveInstance.
+     * 
+     * @return ConstraintLayout* nullptr if the layout does not exist
+     */
+    static ConstraintLayout* getLiveInstance();
+
+    /**
+     * @brief Returns an expression for a quantity of an anchor
+     * 
+     * @details The anchor is added to the layout the first time it is used.
+     * 
+     * @param anchor The anchor
+     * @param attribute The quantity
+     * 
+     * @return Expression
+     */
+    Expression getExpression(Anchor*, const LayoutAttribute&);
+
+    /**
+     * @brief Returns an expression for a quantity of the window
+     * 
+     * @details The window spans the area shown by its view, in world
+     * coordinates (see setWindowArea).
+     * 
+     * @param attribute The quantity
+     * 
+     * @return Expression
+     */
+    Expression getWindowExpression(const LayoutAttribute&) const;
+
+    /**
+     * @brief Adds a constraint
+     * 
+     * @param expression The constrained expression
+     * @param relation How the expression relates to zero
+     * @param strength The priority of the constraint
+     * 
+     * @return ConstraintId INVALID_CONSTRAINT if the constraint cannot be
+     * satisfied
+     */
+    ConstraintId addConstraint(const Expression&,
+                               const Relation&,
+                               const double& = STRENGTH_REQUIRED);
+
+    /**
+     * @brief Constrains two binding points to be a fixed offset apart
+     * 
+     * @details The constraint counterpart of AlignmentTool#createBinding,
+     * which can be overridden by stronger constraints.
+     * 
+     * @param source The bound element
+     * @param anchor The anchor to which the source is bound
+     * @param sourcePoint The point by which the source is bound
+     * @param anchorPoint The point by which the anchor is bound
+     * @param offset The desired offset
+     * @param strength The priority of the binding
+     * 
+     * @return ConstraintId INVALID_CONSTRAINT if the binding cannot be
+     * satisfied
+     */
+    ConstraintId addBinding(Anchor*,
+                            Anchor*,
+                            const BindingPoint&,
+                            const BindingPoint&,
+                            const Point& = Point(),
+                            const double& = STRENGTH_REQUIRED);
+
+    /**
+     * @brief Removes a constraint or a binding
+     * 
+     * @param constraint The constraint
+     * 
+     * @return true The constraint was removed
+     * @return false The constraint does not exist
+     */
+    bool removeConstraint(const ConstraintId&);
+
+    /**
+     * @brief Removes an anchor along with its constraints
+     * 
+     * @details Called automatically when an anchor is destroyed. The
+     * variables of the anchor are released, so expressions obtained for it
+     * must not be used afterwards.
+     * 
+     * @param anchor The anchor to be removed
+     */
+    void remove(const Anchor*);
+
+    /**
+     * @brief Updates the area shown by the window
+     * 
+     * @details Called by the application whenever the window is resized,
+     * with the area its view shows in world coordinates.
+     * 
+     * @param area The visible area
+     */
+    void setWindowArea(const ::sf::FloatRect&);
+
+    /**
+     * @brief Moves the elements whose solution changed
+     * 
+     * @details Measures the elements which changed since the previous
+     * update first, so that changes of their sizes are taken into account.
+     * Anchors which are not components cannot report their changes, so they
+     * are measured every time. Called by the application before drawing.
+     * 
+     * @return size_t The number of elements moved
+     */
+    size_t update();
+
+    /**
+     * @brief Queues a component to be measured on the next update
+     * 
+     * @param component The component that changed
+     */
+    void onComponentUpdate(Component&) override;
+
+    /**
+     * @brief Stops laying out a component which is being destroyed
+     * 
+     * @param component The component being destroyed
+     */
+    void onComponentDestroyed(Component&) override;
+
+    /**
+     * @brief Returns the number of constraints and bindings
+     * 
+     * @return size_t
+     */
+    size_t getConstraintCount() const;
+ private:
+    enum Quantity {
+        QUANTITY_LEFT,
+        QUANTITY_TOP,
+        QUANTITY_WIDTH,
+        QUANTITY_HEIGHT,
+        QUANTITY_COUNT
+    };
+
+    struct Entry {
+        Anchor* anchor = nullptr;
+
+        // nullptr for anchors which are not moved by the layout
+        Component* target = nullptr;
+
+        Variable variables[QUANTITY_COUNT];
+
+        // The last values measured or applied
+        double values[QUANTITY_COUNT] = {0.0, 0.0, 0.0, 0.0};
+
+        // Number of constraint terms referring to each quantity
+        uint32_t uses[QUANTITY_COUNT] = {0, 0, 0, 0};
+
+        ::std::vector<ConstraintId> constraints;
+    };
+
+    struct Owner {
+        const Anchor* anchor = nullptr;
+        Quantity quantity = QUANTITY_LEFT;
+    };
+
+    // Constraints of the layout, each made of one or more of the solver
+    struct Group {
+        ::std::vector<ConstraintId> constraints;
+        ::std::vector<Variable> variables;
+    };
+
+    ConstraintSolver _solver;
+
+    ::std::unordered_map<const Anchor*, Entry> _entries;
+    // The anchor of each variable, by id
+    ::std::vector<Owner> _owners;
+
+    ::std::unordered_map<ConstraintId, Group> _groups;
+    ConstraintId _nextGroup = INVALID_CONSTRAINT + 1;
+
+    // The anchor of each observed component
+    ::std::unordered_map<const Component*, const Anchor*> _targets;
+
+    // Anchors to be measured on the next update
+    ::std::unordered_set<const Anchor*> _changed;
+    ::std::unordered_set<const Anchor*> _unobserved;
+
+    // Anchors whose position must be read back on the next update
+    ::std::unordered_set<const Anchor*> _outdated;
+
+    Variable _windowLeft;
+    Variable _windowTop;
+    Variable _windowWidth;
+    Variable _windowHeight;
+
+    /**
+     * @brief Returns the entry of an anchor, adding it if needed
+     * 
+     * @param anchor The anchor
+     * 
+     * @return Entry&
+     */
+    Entry& getEntry(Anchor*);
+
+    /**
+     * @brief Reads the position and the size of an anchor
+     * 
+     * @param anchor The anchor
+     * @param values Receives the quantities of the anchor
+     */
+    void measure(const Anchor&, double*) const;
+
+    /**
+     * @brief Suggests the quantities of an anchor which changed
+     * 
+     * @param anchor The anchor
+     */
+    void remeasure(const Anchor*);
+
+    Expression getExpression(const Entry&, const LayoutAttribute&) const;
+    Expression getPointX(Anchor*, const BindingPoint&);
+    Expression getPointY(Anchor*, const BindingPoint&);
+
+    /**
+     * @brief Adds constraints to the solver as a single one
+     * 
+     * @param expressions The constrained expressions
+     * @param relation How the expressions relate to zero
+     * @param strength The priority of the constraints
+     * 
+     * @return ConstraintId INVALID_CONSTRAINT if any of them cannot be
+     * satisfied, in which case none is added
+     */
+    ConstraintId addGroup(const ::std::vector<Expression>&,
+                          const Relation&,
+                          const double&);
+
+    /**
+     * @brief Constructor
+     * 
+     */
+    ConstraintLayout();
+};
+
+}  // namespace easyGUI
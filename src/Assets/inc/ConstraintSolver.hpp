@@ -0,0 +1,564 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file ConstraintSolver.hpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Definition of the ConstraintSolver class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#pragma once
+
+// Including dependencies
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+    #include <assets-export.hpp>
+#endif
+
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <Exceptions/AssetException.hpp>
+
+
+namespace easyGUI {
+
+/**
+ * @brief Priorities of the constraints
+ * 
+ * @details Required constraints must hold. The others are satisfied as
+ * well as possible, a stronger one always winning over any number of
+ * weaker ones.
+ */
+constexpr double STRENGTH_REQUIRED = 1001001000.0;
+constexpr double STRENGTH_STRONG = 1000000.0;
+constexpr double STRENGTH_MEDIUM = 1000.0;
+constexpr double STRENGTH_WEAK = 1.0;
+
+/**
+ * @brief Relation between an expression and zero
+ * 
+ */
+enum Relation {
+    LESS_EQUAL,
+    EQUAL,
+    GREATER_EQUAL
+};
+
+/**
+ * @brief A variable of a ConstraintSolver
+ * 
+ * @details Variables are created by the solver and are only valid for the
+ * solver that created them.
+ */
+struct Variable {
+    uint32_t id = 0;
+};
+
+using ConstraintId = uint32_t;
+
+constexpr ConstraintId INVALID_CONSTRAINT = 0;
+
+/**
+ * @brief A linear expression over variables
+ * 
+ * @details Represents the sum of its terms and of a constant, e.g.
+ * Expression(right).add(left, -1).add(-10) is right - left - 10.
+ */
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+class ASSETS_EXPORTS Expression
+#else
+class Expression
+#endif
+{
+ public:
+    struct Term {
+        Variable variable;
+        double coefficient;
+    };
+
+    /**
+     * @brief Constructor
+     * 
+     */
+    Expression() = default;
+
+    /**
+     * @brief Constructs a constant expression
+     * 
+     * @param constant The value of the expression
+     */
+    explicit Expression(const double&);
+
+    /**
+     * @brief Constructs an expression of a single term
+     * 
+     * @param variable The variable
+     * @param coefficient The coefficient of the variable
+     */
+    explicit Expression(const Variable&, const double& = 1.0);
+
+    /**
+     * @brief Adds a term to the expression
+     * 
+     * @param variable The variable
+     * @param coefficient The coefficient of the variable
+     * 
+     * @return Expression& The expression itself
+     */
+    Expression& add(const Variable&, const double& = 1.0);
+
+    /**
+     * @brief Adds another expression, scaled, to the expression
+     * 
+     * @param other The expression to be added
+     * @param coefficient The factor applied to the other expression
+     * 
+     * @return Expression& The expression itself
+     */
+    Expression& add(const Expression&, const double& = 1.0);
+
+    /**
+     * @brief Adds a constant to the expression
+     * 
+     * @param constant The constant to be added
+     * 
+     * @return Expression& The expression itself
+     */
+    Expression& add(const double&);
+
+    Expression operator+ (const Expression&) const;
+    Expression operator- (const Expression&) const;
+    Expression operator+ (const double&) const;
+    Expression operator- (const double&) const;
+    Expression operator* (const double&) const;
+
+    /**
+     * @brief Returns the terms of the expression
+     * 
+     * @return const ::std::vector<Term>&
+     */
+    const ::std::vector<Term>& getTerms() const;
+
+    /**
+     * @brief Returns the constant of the expression
+     * 
+     * @return double
+     */
+    double getConstant() const;
+ private:
+    ::std::vector<Term> _terms;
+    double _constant = 0.0;
+};
+
+/**
+ * @brief Incremental solver of linear constraints
+ * 
+ * @details Implements the Cassowary algorithm: constraints are kept in a
+ * simplex tableau which is updated on every change instead of being solved
+ * from scratch. Adding or removing a constraint only pivots the rows it
+ * affects, and suggesting a new value for an edit variable (e.g. the width
+ * of the window) is resolved by a few dual simplex pivots, which is what
+ * keeps large layouts responsive while they are resized.
+ * 
+ * Every constraint has the form "expression relation 0", e.g.
+ * 
+ * solver.addConstraint(Expression(right) - Expression(left) - 100.0,
+ *                      GREATER_EQUAL, STRENGTH_STRONG);
+ */
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+class ASSETS_EXPORTS ConstraintSolver
+#else
+class ConstraintSolver
+#endif
+{
+ public:
+    /**
+     * @brief Destructor
+     * 
+     */
+    virtual ~ConstraintSolver() = default;
+
+    /**
+     * @brief Constructor
+     * 
+     */
+    ConstraintSolver();
+
+    /**
+     * @brief Creates a new variable
+     * 
+     * @details Reuses the slot of a released variable, if there is one.
+     * 
+     * @return Variable
+     */
+    Variable createVariable();
+
+    /**
+     * @brief Releases a variable, so that its slot can be reused
+     * 
+     * @details The variable must no longer be editable nor be part of any
+     * constraint. It becomes unknown to the solver, and a variable created
+     * later may get the same id.
+     * 
+     * @param variable The variable
+     * 
+     * @return true The variable was released
+     * @return false The variable is unknown or still in use
+     */
+    bool releaseVariable(const Variable&);
+
+    /**
+     * @brief Returns the value of a variable in the current solution
+     * 
+     * @param variable The variable
+     * 
+     * @return double 0 for variables that no constraint decides
+     */
+    double getValue(const Variable&) const;
+
+    /**
+     * @brief Adds a constraint
+     * 
+     * @details Required constraints which cannot be satisfied are reported
+     * and left out, without altering the solution.
+     * 
+     * @param expression The constrained expression
+     * @param relation How the expression relates to zero
+     * @param strength The priority of the constraint
+     * 
+     * @return ConstraintId INVALID_CONSTRAINT if the constraint was left out
+     */
+    ConstraintId addConstraint(const Expression&,
+                               const Relation&,
+                               const double& = STRENGTH_REQUIRED);
+
+    /**
+     * @brief Removes a constraint
+     * 
+     * @param constraint The constraint to be removed
+     * 
+     * @return true The constraint was removed
+     * @return false The constraint does not exist
+     */
+    bool removeConstraint(const ConstraintId&);
+
+    /**
+     * @brief Checks if a constraint exists
+     * 
+     * @param constraint The constraint
+     * 
+     * @return true The constraint exists
+     * @return false otherwise
+     */
+    bool hasConstraint(const ConstraintId&) const;
+
+    /**
+     * @brief Allows a variable to be given values through suggestValue
+     * 
+     * @param variable The variable
+     * @param strength How strongly the suggested values are kept, which
+     * must be lower than STRENGTH_REQUIRED
+     * 
+     * @return true The variable can be edited
+     * @return false The variable is unknown or already editable
+     */
+    bool addEditVariable(const Variable&, const double&);
+
+    /**
+     * @brief Stops a variable from being edited
+     * 
+     * @param variable The variable
+     * 
+     * @return true The variable is no longer editable
+     * @return false The variable was not editable
+     */
+    bool removeEditVariable(const Variable&);
+
+    /**
+     * @brief Checks if a variable is editable
+     * 
+     * @param variable The variable
+     * 
+     * @return true The variable is editable
+     * @return false otherwise
+     */
+    bool hasEditVariable(const Variable&) const;
+
+    /**
+     * @brief Suggests a value for an edit variable
+     * 
+     * @details The solution is updated right away, only visiting the rows
+     * of the tableau that depend on the variable.
+     * 
+     * @param variable The edit variable
+     * @param value The suggested value
+     * 
+     * @return true The solution was updated
+     * @return false The variable is not editable
+     */
+    bool suggestValue(const Variable&, const double&);
+
+    /**
+     * @brief Returns the number of constraints, edit variables included
+     * 
+     * @return size_t
+     */
+    size_t getConstraintCount() const;
+
+    /**
+     * @brief Returns the variables whose value may have changed
+     * 
+     * @details Covers the changes since the previous call, so that callers
+     * only need to read back the part of the solution that moved.
+     * 
+     * @param variables Receives the variables
+     */
+    void takeChangedVariables(::std::vector<Variable>&);
+
+    /**
+     * @brief Removes all variables and constraints
+     * 
+     */
+    void reset();
+ private:
+    using Symbol = uint32_t;
+
+    enum SymbolType : uint8_t {
+        SYMBOL_INVALID,
+        SYMBOL_EXTERNAL,
+        SYMBOL_SLACK,
+        SYMBOL_ERROR,
+        SYMBOL_DUMMY
+    };
+
+    static constexpr Symbol INVALID_SYMBOL = 0;
+
+    struct Cell {
+        Symbol symbol;
+        double coefficient;
+    };
+
+    // A row of the tableau: 0 = constant + sum of the cells
+    struct Row {
+        double constant = 0.0;
+
+        // Sorted by symbol
+        ::std::vector<Cell> cells;
+
+        ::std::vector<Cell>::iterator locate(const Symbol&);
+        ::std::vector<Cell>::const_iterator locate(const Symbol&) const;
+
+        double coefficientFor(const Symbol&) const;
+        double add(const double&);
+
+        void insert(const Symbol&, const double&);
+        void insert(const Row&, const double&);
+        void remove(const Symbol&);
+        void reverseSign();
+        void solveFor(const Symbol&);
+        void solveFor(const Symbol&, const Symbol&);
+        bool substitute(const Symbol&, const Row&);
+    };
+
+    using RowMap = ::std::unordered_map<Symbol, Row>;
+    using Column = ::std::unordered_set<Symbol>;
+
+    // The symbols marking a constraint in the tableau
+    struct Tag {
+        Symbol marker = INVALID_SYMBOL;
+        Symbol other = INVALID_SYMBOL;
+    };
+
+    struct ConstraintInfo {
+        Tag tag;
+        double strength;
+    };
+
+    struct EditInfo {
+        ConstraintId constraint;
+        Tag tag;
+        double constant;
+    };
+
+    ::std::vector<SymbolType> _types;
+    ::std::vector<Symbol> _variables;
+
+    // Slots left by removed constraints and released variables, so that
+    // the solver does not grow with every change of the layout
+    ::std::vector<Symbol> _freeSymbols;
+    ::std::vector<uint32_t> _freeVariables;
+
+    // The variable of each external symbol, by symbol
+    ::std::vector<uint32_t> _externals;
+    ::std::unordered_set<uint32_t> _changed;
+
+    RowMap _rows;
+
+    // The basic symbols of the rows each symbol appears in, so that pivots
+    // only visit the rows they change instead of the whole tableau. Dummy
+    // symbols pile up in long rows but only enter the basis when their
+    // constraint is removed, so they are looked up by scanning instead.
+    ::std::unordered_map<Symbol, Column> _columns;
+
+    Row _objective;
+    ::std::unique_ptr<Row> _artificial;
+    ::std::vector<Symbol> _infeasible;
+
+    ::std::unordered_map<ConstraintId, ConstraintInfo> _constraints;
+    ::std::unordered_map<uint32_t, EditInfo> _edits;
+    ConstraintId _nextConstraint = INVALID_CONSTRAINT + 1;
+
+    bool isValid(const Variable&) const;
+    bool isPivotable(const Symbol&) const;
+    Symbol newSymbol(const SymbolType&);
+
+    /**
+     * @brief Makes a symbol available to newSymbol again
+     * 
+     * @details The symbol must no longer appear in the tableau.
+     * 
+     * @param symbol The symbol
+     */
+    void freeSymbol(const Symbol&);
+
+    /**
+     * @brief Records that the value of a basic symbol may have changed
+     * 
+     * @param basic The basic symbol
+     */
+    void markChanged(const Symbol&);
+
+    /**
+     * @brief Adds a row to the tableau, indexing its symbols
+     * 
+     * @param basic The basic symbol of the row
+     * @param row The row
+     */
+    void insertRow(const Symbol&, Row&&);
+
+    /**
+     * @brief Removes a row from the tableau
+     * 
+     * @param it The row to be removed
+     * 
+     * @return Row The removed row
+     */
+    Row extractRow(RowMap::iterator);
+
+    void eraseFromColumn(const Symbol&, const Symbol&);
+
+    /**
+     * @brief Removes a symbol from the tableau
+     * 
+     * @param symbol The symbol to be removed
+     */
+    void eraseSymbol(const Symbol&);
+
+    /**
+     * @brief Returns the basic symbols of the rows containing a symbol
+     * 
+     * @param symbol The symbol
+     * 
+     * @return ::std::vector<Symbol>
+     */
+    ::std::vector<Symbol> findRows(const Symbol&) const;
+
+    /**
+     * @brief Converts a constraint to a row of the tableau
+     * 
+     * @details Adds the slack, error and dummy symbols of the constraint,
+     * the error symbols also being added to the objective.
+     * 
+     * @param expression The constrained expression
+     * @param relation How the expression relates to zero
+     * @param strength The priority of the constraint
+     * @param tag Receives the symbols marking the constraint
+     * 
+     * @return Row
+     */
+    Row createRow(const Expression&, const Relation&, const double&, Tag&);
+
+    Symbol chooseSubject(const Row&, const Tag&) const;
+    Symbol anyPivotableSymbol(const Row&) const;
+    bool allDummies(const Row&) const;
+
+    /**
+     * @brief Adds a row which has no obvious basic symbol
+     * 
+     * @details Solves a second problem, minimizing an artificial symbol.
+     * The row is dropped if it cannot be satisfied.
+     * 
+     * @param row The row to be added
+     * 
+     * @return true The row was added
+     * @return false The row cannot be satisfied
+     */
+    bool addWithArtificialVariable(const Row&);
+
+    /**
+     * @brief Replaces a symbol with a row in the whole tableau
+     * 
+     * @param symbol The symbol to be replaced
+     * @param row The row replacing it
+     */
+    void substitute(const Symbol&, const Row&);
+
+    /**
+     * @brief Minimizes an objective through primal simplex pivots
+     * 
+     * @param objective The objective
+     * 
+     * @return true The optimum was reached
+     * @return false The objective is unbounded
+     */
+    bool optimize(Row&);
+
+    /**
+     * @brief Restores feasibility through dual simplex pivots
+     * 
+     * @details Called after edit variables change, which only makes the
+     * rows that depend on them infeasible.
+     * 
+     * @return true The tableau is feasible
+     * @return false The tableau could not be made feasible
+     */
+    bool dualOptimize();
+
+    Symbol getEnteringSymbol(const Row&) const;
+    Symbol getDualEnteringSymbol(const Row&) const;
+    RowMap::iterator getLeavingRow(const Symbol&);
+    RowMap::iterator getMarkerLeavingRow(const Symbol&);
+
+    /**
+     * @brief Removes the error symbols of a constraint from the objective
+     * 
+     * @param marker The error symbol
+     * @param strength The priority of the constraint
+     */
+    void removeMarkerEffects(const Symbol&, const double&);
+};
+
+}  // namespace easyGUI
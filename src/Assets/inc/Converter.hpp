@@ -48,6 +48,8 @@ namespace easyGUI {
 /**
  * @brief Responsible for conversions between components
  * 
+ * @details Conversions rely on the type tags of the components, so they do
+ * not need RTTI. Converting to a type the component is not returns nullptr.
  */
 #if defined(_WIN32) && BUILD_SHARED_LIBRARIES
 class ASSETS_EXPORTS Converter
@@ -56,6 +58,23 @@ class Converter
 #endif
 {
  public:
+    /**
+     * @brief Converts a component into any registered type
+     * 
+     * @tparam T A type registered through TaggedComponent
+     * 
+     * @param asset The component to be converted
+     * 
+     * @return ::std::shared_ptr<T> nullptr if the component is not a T
+     */
+    template <class T>
+    static ::std::shared_ptr<T> as(const ::std::shared_ptr<Component>& asset) {
+        if (asset && asset->is<T>())
+            return ::std::static_pointer_cast<T>(asset);
+
+        return nullptr;
+    }
+
     /**
      * @brief Converts a Component object into a button
      * 
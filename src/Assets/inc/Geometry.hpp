@@ -0,0 +1,226 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file Geometry.hpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Definition of the Geometry class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#pragma once
+
+// Including dependencies
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+    #include <assets-export.hpp>
+#endif
+
+#include <cstdint>
+#include <vector>
+
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+
+namespace easyGUI {
+
+/**
+ * @brief Geometry of a component, ready to be batched
+ * 
+ * @details Components describe what they draw as a sequence of primitives.
+ * A primitive is either a list of triangles in world coordinates, sharing
+ * the same texture (or no texture at all), or a drawable that cannot be
+ * merged with anything else. Primitives are listed in the order they are
+ * drawn.
+ */
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+class ASSETS_EXPORTS Geometry
+#else
+class Geometry
+#endif
+{
+ public:
+    /**
+     * @brief Part of the geometry drawn with the same states
+     * 
+     */
+    struct Primitive {
+        const ::sf::Texture* texture = nullptr;
+        const ::sf::Drawable* drawable = nullptr;
+
+        uint32_t first = 0;
+        uint32_t count = 0;
+
+        ::sf::FloatRect bounds;
+    };
+
+    /**
+     * @brief Destructor
+     * 
+     */
+    virtual ~Geometry() = default;
+
+    /**
+     * @brief Constructor
+     * 
+     */
+    Geometry() = default;
+
+    /**
+     * @brief Removes all primitives
+     * 
+     */
+    void clear();
+
+    /**
+     * @brief Adds the fill and outline of an untextured shape
+     * 
+     * @details Textured shapes are added as drawables.
+     * 
+     * @param shape The shape to be added
+     */
+    void addShape(const ::sf::Shape&);
+
+    /**
+     * @brief Adds a sprite as a textured quad
+     * 
+     * @param sprite The sprite to be added
+     */
+    void addSprite(const ::sf::Sprite&);
+
+    /**
+     * @brief Adds the glyphs of a text as textured quads
+     * 
+     * @details The quads are built the same way ::sf::Text builds them and
+     * use the glyph texture of the font for the text's character size, so
+     * texts sharing a font and a character size end up in the same batch.
+     * 
+     * @param text The text to be added
+     */
+    void addText(const ::sf::Text&);
+
+    /**
+     * @brief Adds a drawable that is drawn on its own
+     * 
+     * @details The drawable must outlive the geometry.
+     * 
+     * @param drawable The drawable to be added
+     * @param bounds The area covered by the drawable
+     */
+    void addDrawable(const ::sf::Drawable&, const ::sf::FloatRect&);
+
+    /**
+     * @brief Returns the vertices of all primitives
+     * 
+     * @return const ::std::vector<::sf::Vertex>&
+     */
+    const ::std::vector<::sf::Vertex>& getVertices() const;
+
+    /**
+     * @brief Returns the primitives, in draw order
+     * 
+     * @return const ::std::vector<Primitive>&
+     */
+    const ::std::vector<Primitive>& getPrimitives() const;
+ private:
+    ::std::vector<::sf::Vertex> _vertices;
+    ::std::vector<Primitive> _primitives;
+
+    /**
+     * @brief Appends a triangle
+     * 
+     * @param first The first vertex
+     * @param second The second vertex
+     * @param third The third vertex
+     */
+    void addTriangle(const ::sf::Vertex&,
+                     const ::sf::Vertex&,
+                     const ::sf::Vertex&);
+
+    /**
+     * @brief Appends a quad as two triangles
+     * 
+     * @param topLeft The top left corner
+     * @param topRight The top right corner
+     * @param bottomRight The bottom right corner
+     * @param bottomLeft The bottom left corner
+     */
+    void addQuad(const ::sf::Vertex&,
+                 const ::sf::Vertex&,
+                 const ::sf::Vertex&,
+                 const ::sf::Vertex&);
+
+    /**
+     * @brief Appends the quad of a glyph
+     * 
+     * @param transform The transform of the text
+     * @param position The position of the glyph, in local coordinates
+     * @param color The color of the glyph
+     * @param glyph The glyph to be added
+     * @param shear The italic shear of the text
+     * @param outline The outline thickness the glyph was rendered with
+     */
+    void addGlyph(const ::sf::Transform&,
+                  const ::sf::Vector2f&,
+                  const ::sf::Color&,
+                  const ::sf::Glyph&,
+                  const float&,
+                  const float&);
+
+    /**
+     * @brief Appends an underline or a strike-through line
+     * 
+     * @param transform The transform of the text
+     * @param length The length of the line
+     * @param top The baseline of the text line
+     * @param color The color of the line
+     * @param offset The offset of the line from the baseline
+     * @param thickness The thickness of the line
+     * @param outline The outline thickness of the text
+     */
+    void addLine(const ::sf::Transform&,
+                 const float&,
+                 const float&,
+                 const ::sf::Color&,
+                 const float&,
+                 const float&,
+                 const float&);
+
+    /**
+     * @brief Starts a primitive, or continues the last one
+     * 
+     * @details The last primitive is continued if it uses the same texture.
+     * The vertices added afterwards belong to the primitive.
+     * 
+     * @param texture The texture of the primitive
+     * @param bounds The area covered by the added vertices
+     */
+    void beginPrimitive(const ::sf::Texture*, const ::sf::FloatRect&);
+};
+
+}  // namespace easyGUI
@@ -52,9 +52,13 @@ namespace easyGUI {
  * 
  */
 #if defined(_WIN32) && BUILD_SHARED_LIBRARIES
-class ASSETS_EXPORTS Image : public Component, public Anchor
+class ASSETS_EXPORTS Image
+    : public TaggedComponent<Image, Component, TAG_IMAGE>,
+      public Anchor
 #else
-class Image : public Component, public Anchor
+class Image
+    : public TaggedComponent<Image, Component, TAG_IMAGE>,
+      public Anchor
 #endif
 {
  public:
@@ -99,19 +103,27 @@ class Image : public Component, public Anchor
     Image& operator= (const Image&) = delete;
 
     /**
-     * @brief Check if mouse is over the button
+     * @brief Updates a component's location
      * 
-     * @return true Mouse is over the label
-     * @return false otherwise
+     * @param newLocation The new location of the component
      */
-    bool isMouseHover() const override;
+    void updateLocation(const Point&) override;
 
     /**
-     * @brief Updates a component's location
+     * @brief Returns the axis-aligned bounds of the component
      * 
-     * @param newLocation The new location of the component
+     * @return ::sf::FloatRect
      */
-    void updateLocation(const Point&) override;
+    ::sf::FloatRect getBounds() const override;
+
+    /**
+     * @brief Describes what the component draws, for batching
+     * 
+     * @param geometry Where the primitives of the component are added
+     * 
+     * @return true
+     */
+    bool buildGeometry(Geometry&) const override;
 
     /**
      * @brief Hides / Shows the image frame.
@@ -127,11 +139,23 @@ class Image : public Component, public Anchor
     Point getBOTTOM() const override;
     Point getTOP() const override;
     Point getCENTER() const override;
+
+    /**
+     * @brief Returns the component behind the anchor
+     * 
+     * @return Component*
+     */
+    Component* toComponent() override {
+        return this;
+    }
  private:
     ::std::shared_ptr<::sf::Texture> _image;
     ::std::shared_ptr<::sf::RectangleShape> _border;
     ::sf::Sprite _object;
 
+    // Calls draw directly, without virtual dispatch
+    friend class StaticDispatcher;
+
     void draw(::sf::RenderTarget&, ::sf::RenderStates) const override;
 
     /**
@@ -68,9 +68,13 @@ enum TextDecoration {
  * labels, you can inherit this class.
  */
 #if defined(_WIN32) && BUILD_SHARED_LIBRARIES
-class ASSETS_EXPORTS Label : public Component, public Anchor
+class ASSETS_EXPORTS Label
+    : public TaggedComponent<Label, Component, TAG_LABEL>,
+      public Anchor
 #else
-class Label : public Component, public Anchor
+class Label
+    : public TaggedComponent<Label, Component, TAG_LABEL>,
+      public Anchor
 #endif
 {
  public:
@@ -119,16 +123,6 @@ class Label : public Component, public Anchor
     Label(const Label&)= delete;
     Label& operator= (const Label&)= delete;
 
-    // ----- Auxiliaries -----
-
-    /**
-     * @brief Check if mouse is over the button
-     * 
-     * @return true Mouse is over the label
-     * @return false otherwise
-     */
-    bool isMouseHover() const override;
-
     // ----- Getters -----
 
     /**
@@ -145,6 +139,22 @@ class Label : public Component, public Anchor
      */
     void updateLocation(const Point&) override;
 
+    /**
+     * @brief Returns the axis-aligned bounds of the component
+     * 
+     * @return ::sf::FloatRect
+     */
+    ::sf::FloatRect getBounds() const override;
+
+    /**
+     * @brief Describes what the component draws, for batching
+     * 
+     * @param geometry Where the primitives of the component are added
+     * 
+     * @return true
+     */
+    bool buildGeometry(Geometry&) const override;
+
     /**
      * @brief Applies / removes a specific decoration
      * 
@@ -159,11 +169,23 @@ class Label : public Component, public Anchor
     Point getBOTTOM() const override;
     Point getTOP() const override;
     Point getCENTER() const override;
+
+    /**
+     * @brief Returns the component behind the anchor
+     * 
+     * @return Component*
+     */
+    Component* toComponent() override {
+        return this;
+    }
  private:
     ::std::shared_ptr<::sf::Font> _font;
     ::std::vector<TextDecoration> _decorations;
     ::sf::Text _text;
 
+    // Calls draw directly, without virtual dispatch
+    friend class StaticDispatcher;
+
     void draw(::sf::RenderTarget&, ::sf::RenderStates) const override;
 };
 
@@ -50,9 +50,11 @@ namespace easyGUI {
  * 
  */
 #if defined(_WIN32) && BUILD_SHARED_LIBRARIES
-class ASSETS_EXPORTS PasswordBox : public TextBox
+class ASSETS_EXPORTS PasswordBox
+    : public TaggedComponent<PasswordBox, TextBox, TAG_PASSWORDBOX>
 #else
-class PasswordBox : public TextBox
+class PasswordBox
+    : public TaggedComponent<PasswordBox, TextBox, TAG_PASSWORDBOX>
 #endif
 {
  public:
@@ -50,9 +50,13 @@ namespace easyGUI {
  * You can also set whether the line is vertical or horizontal.
  */
 #if defined(_WIN32) && BUILD_SHARED_LIBRARIES
-class ASSETS_EXPORTS Separator : public Component, public Anchor
+class ASSETS_EXPORTS Separator
+    : public TaggedComponent<Separator, Component, TAG_SEPARATOR>,
+      public Anchor
 #else
-class Separator : public Component, public Anchor
+class Separator
+    : public TaggedComponent<Separator, Component, TAG_SEPARATOR>,
+      public Anchor
 #endif
 {
  public:
@@ -80,16 +84,6 @@ class Separator : public Component, public Anchor
     Separator( const Separator& ) = delete;
     Separator& operator= ( const Separator& ) = delete;
 
-    // ----- Auxiliaries -----
-
-    /**
-     * @brief Check if mouse is over the button
-     * 
-     * @return true Mouse is over the label
-     * @return false otherwise
-     */
-    bool isMouseHover() const override;
-
     // ----- Getters -----
 
     /**
@@ -106,6 +100,22 @@ class Separator : public Component, public Anchor
      */
     void updateLocation(const Point&) override;
 
+    /**
+     * @brief Returns the axis-aligned bounds of the component
+     * 
+     * @return ::sf::FloatRect
+     */
+    ::sf::FloatRect getBounds() const override;
+
+    /**
+     * @brief Describes what the component draws, for batching
+     * 
+     * @param geometry Where the primitives of the component are added
+     * 
+     * @return true
+     */
+    bool buildGeometry(Geometry&) const override;
+
     // ----- Inherited from Anchor -----
 
     Point getLEFT() const override;
@@ -113,9 +123,21 @@ class Separator : public Component, public Anchor
     Point getBOTTOM() const override;
     Point getTOP() const override;
     Point getCENTER() const override;
+
+    /**
+     * @brief Returns the component behind the anchor
+     * 
+     * @return Component*
+     */
+    Component* toComponent() override {
+        return this;
+    }
  private:
     ::sf::RectangleShape _shape;
 
+    // Calls draw directly, without virtual dispatch
+    friend class StaticDispatcher;
+
     void draw(::sf::RenderTarget&, ::sf::RenderStates) const override;
 };
 
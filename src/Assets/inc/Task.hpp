@@ -30,6 +30,10 @@
 #pragma once
 
 // Including dependencies
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+    #include <assets-export.hpp>
+#endif
+
 #include <memory>
 
 
@@ -43,6 +47,10 @@ namespace easyGUI {
  * This way, any derived class will be compatible with methods
  * such as onClick() and onHover()
  * 
+ * A task marked as asynchronous is handed to the installed TaskScheduler
+ * instead of running on the UI thread. Once it finishes, onComplete() is
+ * called back on the UI thread, where it is safe to update components.
+ * 
  * @warning This class cannot be used as a standalone.
  */
 class Task {
@@ -64,6 +72,84 @@ class Task {
      * 
      */
     virtual void exec() {}
+
+    /**
+     * @brief Called on the UI thread after an asynchronous execution
+     * 
+     */
+    virtual void onComplete() {}
+
+    /**
+     * @brief Marks the task as asynchronous
+     * 
+     * @param async Denotes whether the task runs off the UI thread
+     */
+    void setAsync(const bool& async) {
+        _async = async;
+    }
+
+    /**
+     * @brief Checks if the task runs asynchronously
+     * 
+     * @return bool
+     */
+    bool isAsync() const {
+        return _async;
+    }
+ private:
+    bool _async = false;
+};
+
+/**
+ * @brief Interface for executors of asynchronous tasks
+ * 
+ * @details Components and routines run their tasks through
+ * TaskScheduler::run, which forwards asynchronous tasks to the installed
+ * scheduler. Without a scheduler, every task runs synchronously.
+ */
+#if defined(_WIN32) && BUILD_SHARED_LIBRARIES
+class ASSETS_EXPORTS TaskScheduler
+#else
+class TaskScheduler
+#endif
+{
+ public:
+    /**
+     * @brief Destructor
+     * 
+     */
+    virtual ~TaskScheduler() = default;
+
+    /**
+     * @brief Queues a task for asynchronous execution
+     * 
+     * @param task The task to be executed
+     */
+    virtual void schedule(const ::std::shared_ptr<Task>&) = 0;
+
+    /**
+     * @brief Installs the scheduler used for asynchronous tasks
+     * 
+     * @param scheduler The scheduler, or nullptr to run everything in place
+     */
+    static void setInstance(TaskScheduler*);
+
+    /**
+     * @brief Returns the installed scheduler
+     * 
+     * @return TaskScheduler*
+     */
+    static TaskScheduler* getInstance();
+
+    /**
+     * @brief Runs a task
+     * 
+     * @details Synchronous tasks are executed immediately. Asynchronous
+     * tasks are scheduled if a scheduler is installed.
+     * 
+     * @param task The task to be run
+     */
+    static void run(const ::std::shared_ptr<Task>&);
 };
 
 /**
@@ -77,7 +163,7 @@ template < class Class, class... Args>
 std::shared_ptr<Task> CreateNewTask(Args... constructorArgs) {
     ::std::shared_ptr<Class> ptr =
         ::std::make_shared<Class>(constructorArgs...);
-    return ::std::dynamic_pointer_cast<Task>(ptr);
+    return ::std::static_pointer_cast<Task>(ptr);
 }
 
 }  // namespace easyGUI
@@ -55,9 +55,13 @@ namespace easyGUI {
  * 
  */
 #if defined(_WIN32) && BUILD_SHARED_LIBRARIES
-class ASSETS_EXPORTS TextBox : public Component, public Anchor
+class ASSETS_EXPORTS TextBox
+    : public TaggedComponent<TextBox, Component, TAG_TEXTBOX>,
+      public Anchor
 #else
-class TextBox : public Component, public Anchor
+class TextBox
+    : public TaggedComponent<TextBox, Component, TAG_TEXTBOX>,
+      public Anchor
 #endif
 {
  public:
@@ -119,14 +123,6 @@ class TextBox : public Component, public Anchor
 
     // ----- Auxiliaries -----
 
-    /**
-     * @brief Check if mouse is over the button
-     * 
-     * @return true Mouse is over the label
-     * @return false otherwise
-     */
-    bool isMouseHover() const override;
-
     /**
      * @brief Updates the text of the keyboard
      * 
@@ -166,8 +162,10 @@ class TextBox : public Component, public Anchor
     /**
      * @brief Updates the selected text box
      * 
+     * @param point The position of the click in world coordinates
      */
-    void onClick() override;
+    void onClick(const Point&) override;
+    using Component::onClick;
 
     /**
      * @brief Updates a component's location
@@ -176,6 +174,22 @@ class TextBox : public Component, public Anchor
      */
     void updateLocation(const Point&) override;
 
+    /**
+     * @brief Returns the axis-aligned bounds of the component
+     * 
+     * @return ::sf::FloatRect
+     */
+    ::sf::FloatRect getBounds() const override;
+
+    /**
+     * @brief Describes what the component draws, for batching
+     * 
+     * @param geometry Where the primitives of the component are added
+     * 
+     * @return true
+     */
+    bool buildGeometry(Geometry&) const override;
+
     // ----- Inherited from Anchor -----
 
     Point getLEFT() const override;
@@ -183,6 +197,15 @@ class TextBox : public Component, public Anchor
     Point getBOTTOM() const override;
     Point getTOP() const override;
     Point getCENTER() const override;
+
+    /**
+     * @brief Returns the component behind the anchor
+     * 
+     * @return Component*
+     */
+    Component* toComponent() override {
+        return this;
+    }
  protected:
     ::sf::RectangleShape _shape;
     ::std::shared_ptr<Label> _text;
@@ -192,6 +215,9 @@ class TextBox : public Component, public Anchor
 
     uint32_t desiredSize;
 
+    // Calls draw directly, without virtual dispatch
+    friend class StaticDispatcher;
+
     void draw(::sf::RenderTarget&, ::sf::RenderStates) const override;
 
     // ----- Helper methods -----
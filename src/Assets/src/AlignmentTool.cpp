@@ -27,6 +27,9 @@
  * @copyright Copyright (c) 2022
  */
 
+#include <algorithm>
+
+#include <ConstraintLayout.hpp>
 #include <AlignmentTool.hpp>
 
 namespace easyGUI {
@@ -48,12 +51,49 @@ Point Anchor::getBindingPoint(const BindingPoint& point) const {
     }
 }
 
+// Anchors may outlive the tool when they are destroyed at exit
+static AlignmentTool* liveInstance = nullptr;
+
+Anchor::~Anchor() {
+    AlignmentTool* tool = AlignmentTool::getLiveInstance();
+    ConstraintLayout* layout = ConstraintLayout::getLiveInstance();
+
+    if (tool)
+        tool->unbind(this);
+
+    if (layout)
+        layout->remove(this);
+}
+
+AlignmentTool::AlignmentTool() {
+    liveInstance = this;
+}
+
+AlignmentTool::~AlignmentTool() {
+    liveInstance = nullptr;
+}
+
 AlignmentTool& AlignmentTool::getInstance() {
     static AlignmentTool _instance;
 
     return _instance;
 }
 
+AlignmentTool* AlignmentTool::getLiveInstance() {
+    return liveInstance;
+}
+
+AlignmentTool::ScopeGuard::ScopeGuard(const BindingScope& scope) {
+    AlignmentTool& tool = AlignmentTool::getInstance();
+
+    _previous = tool.getActiveScope();
+    tool.setActiveScope(scope);
+}
+
+AlignmentTool::ScopeGuard::~ScopeGuard() {
+    AlignmentTool::getInstance().setActiveScope(_previous);
+}
+
 Point AlignmentTool::getAlignment(const Binding& binding) noexcept {
     Point desiredLocation = binding.offset +
         binding.anchors[1]->getBindingPoint(binding.points[1]);
@@ -65,18 +105,29 @@ Point AlignmentTool::getAlignment(const Binding& binding) noexcept {
         binding.anchors[0]->getTOP().Ycoord + delta.Ycoord);
 }
 
-bool AlignmentTool::Binding::operator== (const Binding& other) const noexcept {
-    return (anchors[0] == other.anchors[0]) &&
-           (anchors[1] == other.anchors[1]);
+bool AlignmentTool::BindingKey::operator== (
+    const BindingKey& other) const noexcept {
+    return source == other.source && anchor == other.anchor;
 }
 
-void AlignmentTool::createBinding(Anchor* source,
-                                  Anchor* anchor,
-                                  const BindingPoint& sourcePoint,
-                                  const BindingPoint& anchorPoint,
-                                  const Point& offset) {
-    if (!source || !anchor)
-        throw new AssetException("Invalid components to bind.");
+size_t AlignmentTool::BindingKeyHash::operator() (
+    const BindingKey& key) const noexcept {
+    const size_t first = ::std::hash<const Anchor*>()(key.source);
+    const size_t second = ::std::hash<const Anchor*>()(key.anchor);
+
+    return first ^ (second + 0x9e3779b9 + (first << 6) + (first >> 2));
+}
+
+bool AlignmentTool::addBinding(Anchor* source,
+                               Anchor* anchor,
+                               const BindingPoint& sourcePoint,
+                               const BindingPoint& anchorPoint,
+                               const Point& offset) {
+    auto entry = _keys.emplace(BindingKey{source, anchor}, ScopeLink());
+
+    if (!entry.second)
+        // The binding already exists
+        return false;
 
     Binding newBinding;
 
@@ -85,32 +136,346 @@ void AlignmentTool::createBinding(Anchor* source,
     newBinding.points[0] = sourcePoint;
     newBinding.points[1] = anchorPoint;
     newBinding.offset = offset;
+    newBinding.target = source->toComponent();
 
-    if (::std::find(_bindings.begin(), _bindings.end(), newBinding) != _bindings.end())  // NOLINT
-        // The binding already exists
+    if (newBinding.target == nullptr)
+        ERROR << "[AlignmentTool] The bound element is not a component "
+              << "(see Anchor::toComponent), so it will not move.\n";
+
+    _dependents[anchor].push_back(newBinding);
+    _anchors[source].push_back(anchor);
+
+    ScopeLink& link = entry.first->second;
+    Scope& scope = _scopes[_activeScope];
+
+    link.scope = _activeScope;
+    link.key = &entry.first->first;
+    link.next = scope.head;
+
+    if (scope.head)
+        scope.head->previous = &link;
+
+    scope.head = &link;
+
+    return true;
+}
+
+template <class Function>
+void AlignmentTool::forEachDependent(const Anchor* anchor,
+                                     Function function) {
+    auto it = _dependents.find(anchor);
+
+    if (it == _dependents.end())
+        return;
+
+    // Elements of the map keep their address when it rehashes, but
+    // the list itself may grow while the dependents are moved
+    const ::std::vector<Binding>& dependents = it->second;
+
+    for (size_t i = 0; i < dependents.size(); ++i) {
+        const Binding binding = dependents[i];
+
+        function(binding);
+    }
+}
+
+bool AlignmentTool::hasDependents(const Anchor* anchor) const {
+    return _dependents.count(anchor) > 0;
+}
+
+void AlignmentTool::eraseBinding(const Anchor* source, const Anchor* anchor) {
+    auto dependents = _dependents.find(anchor);
+
+    if (dependents != _dependents.end()) {
+        ::std::vector<Binding>& bindings = dependents->second;
+
+        bindings.erase(::std::remove_if(bindings.begin(), bindings.end(),
+            [source](const Binding& binding) {
+                return binding.anchors[0] == source;
+        }), bindings.end());
+
+        if (bindings.empty())
+            _dependents.erase(dependents);
+    }
+
+    auto anchors = _anchors.find(source);
+
+    if (anchors != _anchors.end()) {
+        ::std::vector<const Anchor*>& list = anchors->second;
+
+        list.erase(::std::remove(list.begin(), list.end(), anchor),
+                   list.end());
+
+        if (list.empty())
+            _anchors.erase(anchors);
+    }
+}
+
+bool AlignmentTool::eraseKey(const BindingKey& key) {
+    auto entry = _keys.find(key);
+
+    if (entry == _keys.end())
+        return false;
+
+    const ScopeLink& link = entry->second;
+
+    if (link.next)
+        link.next->previous = link.previous;
+
+    if (link.previous) {
+        link.previous->next = link.next;
+    } else {
+        auto scope = _scopes.find(link.scope);
+
+        if (scope != _scopes.end())
+            scope->second.head = link.next;
+    }
+
+    _keys.erase(entry);
+
+    return true;
+}
+
+void AlignmentTool::unbind(const Anchor* anchor) {
+    _pending.erase(anchor);
+
+    // Elements bound to the anchor are released
+    auto dependents = _dependents.find(anchor);
+
+    if (dependents != _dependents.end()) {
+        const ::std::vector<Binding> bindings = ::std::move(dependents->second);
+
+        _dependents.erase(dependents);
+
+        for (const Binding& binding : bindings) {
+            const Anchor* source = binding.anchors[0];
+
+            eraseKey(BindingKey{source, anchor});
+            eraseBinding(source, anchor);
+        }
+    }
+
+    // The anchor is released from the elements it is bound to
+    auto anchors = _anchors.find(anchor);
+
+    if (anchors == _anchors.end())
         return;
 
-    _bindings.push_back(newBinding);
+    const ::std::vector<const Anchor*> others = ::std::move(anchors->second);
+
+    _anchors.erase(anchors);
+
+    for (const Anchor* other : others) {
+        if (eraseKey(BindingKey{anchor, other}))
+            eraseBinding(anchor, other);
+    }
+}
+
+BindingScope AlignmentTool::createScope() {
+    const BindingScope scope = _nextScope++;
+
+    _scopes.emplace(scope, Scope());
+
+    return scope;
+}
+
+void AlignmentTool::setActiveScope(const BindingScope& scope) {
+    _activeScope = scope;
+}
+
+BindingScope AlignmentTool::getActiveScope() const {
+    return _activeScope;
+}
+
+void AlignmentTool::clearScope(const BindingScope& scope) {
+    auto it = _scopes.find(scope);
+
+    if (it == _scopes.end())
+        return;
+
+    // Only the live bindings of the scope are visited
+    const ScopeLink* link = it->second.head;
+
+    while (link) {
+        const ScopeLink* next = link->next;
+        const BindingKey key = *link->key;
+
+        eraseBinding(key.source, key.anchor);
+        _keys.erase(key);
+
+        link = next;
+    }
+
+    it->second = Scope();
+}
+
+void AlignmentTool::releaseScope(const BindingScope& scope) {
+    clearScope(scope);
+
+    if (scope == GLOBAL_SCOPE)
+        return;
+
+    _scopes.erase(scope);
+
+    if (_activeScope == scope)
+        _activeScope = GLOBAL_SCOPE;
+}
+
+BindingStats AlignmentTool::getStats() const {
+    BindingStats stats;
+
+    stats.bindings = _keys.size();
+    stats.anchors = _dependents.size();
+    stats.scopes = _scopes.size();
+
+    return stats;
+}
+
+void AlignmentTool::createBinding(Anchor* source,
+                                  Anchor* anchor,
+                                  const BindingPoint& sourcePoint,
+                                  const BindingPoint& anchorPoint,
+                                  const Point& offset) {
+    if (!source || !anchor)
+        throw new AssetException("Invalid components to bind.");
 
     // A newly created binding will trigger an update
-    triggerUpdate(anchor);
+    if (addBinding(source, anchor, sourcePoint, anchorPoint, offset))
+        triggerUpdate(anchor);
+}
+
+void AlignmentTool::createBindings(
+    const ::std::vector<BindingDescription>& bindings) {
+    for (const BindingDescription& binding : bindings) {
+        if (!binding.source || !binding.anchor) {
+            ERROR << "[AlignmentTool] Invalid components to bind.\n";
+            continue;
+        }
+
+        if (addBinding(binding.source, binding.anchor, binding.sourcePoint,
+                       binding.anchorPoint, binding.offset))
+            _pending.insert(binding.anchor);
+    }
+
+    // The whole batch is placed by a single pass
+    if (!_deferred && !_solving)
+        solve();
 }
 
 void AlignmentTool::triggerUpdate(const Anchor* source) {
-    ::std::for_each(_bindings.begin(), _bindings.end(),
-        [source, this](Binding& binding) {
-            Component* cast = nullptr;
+    // The solve pass moves the dependents itself
+    if (_solving)
+        return;
 
-            if (binding.anchors[0] == source)
-                cast = dynamic_cast<Component*>(binding.anchors[1]);
-            else if (binding.anchors[1] == source)
-                cast = dynamic_cast<Component*>(binding.anchors[0]);
+    if (!hasDependents(source))
+        return;
+
+    if (_deferred) {
+        _pending.insert(source);
+        return;
+    }
+
+    propagate(source);
+}
 
-            if (!cast)
-                return;
+void AlignmentTool::propagate(const Anchor* source) {
+    if (!_moving.insert(source).second) {
+        ERROR << "[AlignmentTool] Bindings form a cycle, update stopped.\n";
+        return;
+    }
 
-            cast->updateLocation(this->getAlignment(binding));
+    forEachDependent(source, [this](const Binding& binding) {
+        if (binding.target)
+            binding.target->updateLocation(getAlignment(binding));
     });
+
+    _moving.erase(source);
+}
+
+void AlignmentTool::setDeferred(const bool& deferred) {
+    _deferred = deferred;
+
+    // Nothing may be left waiting once updates are immediate again
+    if (!deferred)
+        solve();
+}
+
+bool AlignmentTool::isDeferred() const {
+    return _deferred;
+}
+
+size_t AlignmentTool::solve() {
+    if (_pending.empty())
+        return 0;
+
+    _inDegree.clear();
+    _placements.clear();
+    _stack.clear();
+
+    // Collects the elements reachable from the anchors that moved
+    for (const Anchor* anchor : _pending) {
+        if (_inDegree.emplace(anchor, 0).second)
+            _stack.push_back(anchor);
+    }
+
+    _pending.clear();
+
+    while (!_stack.empty()) {
+        const Anchor* anchor = _stack.back();
+        _stack.pop_back();
+
+        forEachDependent(anchor, [this](const Binding& binding) {
+            auto degree = _inDegree.emplace(binding.anchors[0], 0);
+
+            ++degree.first->second;
+
+            if (degree.second)
+                _stack.push_back(binding.anchors[0]);
+        });
+    }
+
+    // Kahn's algorithm: an element is placed once all its anchors are
+    for (const auto& entry : _inDegree) {
+        if (entry.second == 0)
+            _stack.push_back(entry.first);
+    }
+
+    size_t placed = 0;
+
+    _solving = true;
+
+    while (!_stack.empty()) {
+        const Anchor* anchor = _stack.back();
+        _stack.pop_back();
+        ++placed;
+
+        auto placement = _placements.find(anchor);
+
+        if (placement != _placements.end() && placement->second.target)
+            placement->second.target->updateLocation(
+                placement->second.location);
+
+        forEachDependent(anchor, [this](const Binding& binding) {
+            const Anchor* dependent = binding.anchors[0];
+
+            // The last binding of an element decides its location
+            _placements[dependent] = Placement{binding.target,
+                                               getAlignment(binding)};
+
+            if (--_inDegree[dependent] == 0)
+                _stack.push_back(dependent);
+        });
+    }
+
+    _solving = false;
+
+    const size_t unsolved = _inDegree.size() - placed;
+
+    if (unsolved > 0)
+        ERROR << "[AlignmentTool] " << unsolved
+              << " elements are bound in a cycle and were not moved.\n";
+
+    return unsolved;
 }
 
 void AlignmentTool::triggerUpdate(const AnchorPtr& source) {
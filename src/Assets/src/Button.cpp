@@ -50,6 +50,11 @@ void Button::applyCharSizeCorrection() {
         freeSpaceX = _shape.getGlobalBounds().width - lenghtInPix;
         freeSpaceY = _shape.getGlobalBounds().height - heightInPix;
     }
+
+    // The label was changed through its internal text. The owner draws
+    // the label as part of its own geometry, so it changed as well.
+    _content->markDirty();
+    markDirty();
 }
 
 Button::Button(const Point& startLocation,
@@ -73,6 +78,9 @@ Button::Button(const Point& startLocation,
         if (_content->getInternalText().getCharacterSize() < charSize)
             WARN << "[Button] Text has been resized in order to fit.\n";
 
+        // The label lives as long as the button, whichever menu it is in
+        AlignmentTool::ScopeGuard guard(GLOBAL_SCOPE);
+
         Anchor* cast = static_cast<Anchor*>(_content.get());
         tool.createBinding(
             cast,
@@ -110,16 +118,21 @@ void Button::draw(::sf::RenderTarget& target,
         target.draw(*_content, states);
 }
 
-bool Button::isMouseHover() const {
-    if (_container != nullptr) {
-        ::sf::Vector2i currentPosition = ::sf::Mouse::getPosition(*_container);
-        ::sf::Vector2f worldPos = _container->mapPixelToCoords(currentPosition);
+bool Button::buildGeometry(Geometry& geometry) const {
+    // Subclasses may override draw
+    if (!isExactly<Button>())
+        return false;
 
-        if (_shape.getGlobalBounds().contains(worldPos.x, worldPos.y))
-            return true;
-    }
+    geometry.addShape(_shape);
+
+    if (_content != nullptr)
+        return _content->buildGeometry(geometry);
+
+    return true;
+}
 
-    return false;
+::sf::FloatRect Button::getBounds() const {
+    return _shape.getGlobalBounds();
 }
 
 ::sf::RectangleShape& Button::getInternalButton() {
@@ -135,39 +148,41 @@ bool Button::isMouseHover() const {
 
 void Button::updateLocation(const Point& newLocation) {
     _shape.setPosition(newLocation.Xcoord, newLocation.Ycoord);
+    markDirty();
 
     AlignmentTool& tool = AlignmentTool::getInstance();
     tool.triggerUpdate(this);
 }
 
 Point Button::getLEFT() const {
-    return Point(
-        _shape.getGlobalBounds().left,
-        _shape.getGlobalBounds().top + _shape.getGlobalBounds().height / 2);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left, bounds.top + bounds.height / 2);
 }
 
 Point Button::getRIGHT() const {
-    return Point(
-        _shape.getGlobalBounds().left + _shape.getGlobalBounds().width,
-        _shape.getGlobalBounds().top + _shape.getGlobalBounds().height / 2);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left + bounds.width, bounds.top + bounds.height / 2);
 }
 
 Point Button::getTOP() const {
-    return Point(
-        _shape.getGlobalBounds().left + _shape.getGlobalBounds().width / 2,
-        _shape.getGlobalBounds().top);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left + bounds.width / 2, bounds.top);
 }
 
 Point Button::getBOTTOM() const {
-    return Point(
-        _shape.getGlobalBounds().left + _shape.getGlobalBounds().width / 2,
-        _shape.getGlobalBounds().top + _shape.getGlobalBounds().height);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left + bounds.width / 2, bounds.top + bounds.height);
 }
 
 Point Button::getCENTER() const {
-    return Point(
-        _shape.getGlobalBounds().left + _shape.getGlobalBounds().width / 2,
-        _shape.getGlobalBounds().top + _shape.getGlobalBounds().height / 2);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left + bounds.width / 2,
+                 bounds.top + bounds.height / 2);
 }
 
 }  // namespace easyGUI
@@ -60,29 +60,37 @@ CheckBox::CheckBox(const Point& startLocation,
                    const float& height):
     CheckBox(startLocation, startLocation + Point(width, height)) {}
 
-bool CheckBox::isMouseHover() const {
-    if (_container != nullptr) {
-        ::sf::Vector2i currentPosition = ::sf::Mouse::getPosition(*_container);
-        ::sf::Vector2f worldPos = _container->mapPixelToCoords(currentPosition);
+bool CheckBox::buildGeometry(Geometry& geometry) const {
+    // Subclasses may override draw
+    if (!isExactly<CheckBox>())
+        return false;
 
-        if (_box.getGlobalBounds().contains(worldPos.x, worldPos.y))
-            return true;
-    }
+    geometry.addShape(_box);
+
+    if (_isChecked)
+        geometry.addShape(_filler);
 
-    return false;
+    return true;
+}
+
+::sf::FloatRect CheckBox::getBounds() const {
+    return _box.getGlobalBounds();
 }
 
 void CheckBox::updateLocation(const Point& newLocation) {
     _box.setPosition(newLocation.Xcoord, newLocation.Ycoord);
     _filler.setPosition(newLocation.Xcoord + 5, newLocation.Ycoord + 5);
+    markDirty();
 
     AlignmentTool& tool = AlignmentTool::getInstance();
     tool.triggerUpdate(this);
 }
 
-void CheckBox::onClick() {
-    if (isMouseHover())
+void CheckBox::onClick(const Point& point) {
+    if (isMouseHover(point)) {
         _isChecked = 1 - _isChecked;
+        markDirty();
+    }
 }
 
 bool CheckBox::isChecked() const {
@@ -98,33 +106,36 @@ bool CheckBox::isChecked() const {
 }
 
 Point CheckBox::getLEFT() const {
-    return Point(
-        _box.getGlobalBounds().left - 1,
-        _box.getGlobalBounds().top - 7 + _box.getGlobalBounds().height / 2);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left - 1, bounds.top - 7 + bounds.height / 2);
 }
 
 Point CheckBox::getRIGHT() const {
-    return Point(
-        _box.getGlobalBounds().left - 1 + _box.getGlobalBounds().width,
-        _box.getGlobalBounds().top - 7 + _box.getGlobalBounds().height / 2);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left - 1 + bounds.width,
+                 bounds.top - 7 + bounds.height / 2);
 }
 
 Point CheckBox::getTOP() const {
-    return Point(
-        _box.getGlobalBounds().left - 1 + _box.getGlobalBounds().width / 2,
-        _box.getGlobalBounds().top - 7);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left - 1 + bounds.width / 2, bounds.top - 7);
 }
 
 Point CheckBox::getBOTTOM() const {
-    return Point(
-        _box.getGlobalBounds().left - 1 + _box.getGlobalBounds().width / 2,
-        _box.getGlobalBounds().top - 7+ _box.getGlobalBounds().height);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left - 1 + bounds.width / 2,
+                 bounds.top - 7 + bounds.height);
 }
 
 Point CheckBox::getCENTER() const {
-    return Point(
-        _box.getGlobalBounds().left - 1 + _box.getGlobalBounds().width / 2,
-        _box.getGlobalBounds().top - 7 + _box.getGlobalBounds().height / 2);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left - 1 + bounds.width / 2,
+                 bounds.top - 7 + bounds.height / 2);
 }
 
 }  // namespace easyGUI
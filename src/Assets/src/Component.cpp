@@ -27,18 +27,125 @@
  * @copyright Copyright (c) 2022
  */
 
+#include <algorithm>
+
 #include <Component.hpp>
 
 namespace easyGUI {
 
+// Covers any point a view can reasonably show
+static const ::sf::FloatRect UNBOUNDED(-1e30f, -1e30f, 2e30f, 2e30f);
+
+Component::~Component() {
+    // Copied, since the observers may unregister themselves
+    const ::std::vector<ComponentObserver*> observers = _observers;
+
+    for (ComponentObserver* observer : observers)
+        observer->onComponentDestroyed(*this);
+}
+
+bool Component::isMouseHover() const {
+    // Without bounds, only an override can tell
+    if (!hasBounds())
+        return false;
+
+    if (_clickPoint != nullptr)
+        return isMouseHover(*_clickPoint);
+
+    if (_container != nullptr) {
+        ::sf::Vector2i currentPosition = ::sf::Mouse::getPosition(*_container);
+        ::sf::Vector2f worldPos = _container->mapPixelToCoords(currentPosition);
+
+        return isMouseHover(Point(worldPos));
+    }
+
+    return false;
+}
+
+bool Component::isMouseHover(const Point& point) const {
+    if (!hasBounds())
+        return isMouseHover();
+
+    return getCachedBounds().contains(point.Xcoord, point.Ycoord);
+}
+
+::sf::FloatRect Component::getBounds() const {
+    _hasBounds = false;
+
+    return ::sf::FloatRect();
+}
+
+const ::sf::FloatRect& Component::getCachedBounds() const {
+    if (!_boundsValid) {
+        _bounds = getBounds();
+        _boundsValid = true;
+    }
+
+    return _bounds;
+}
+
+bool Component::hasBounds() const {
+    getCachedBounds();
+
+    return _hasBounds;
+}
+
+::sf::FloatRect Component::getExtent() const {
+    if (!hasBounds())
+        return UNBOUNDED;
+
+    return getCachedBounds();
+}
+
 void Component::onClick() {
+    // Called directly, the click happens where the mouse is
+    if (_clickPoint == nullptr) {
+        if (_container != nullptr) {
+            ::sf::Vector2i position = ::sf::Mouse::getPosition(*_container);
+
+            onClick(Point(_container->mapPixelToCoords(position)));
+        }
+
+        return;
+    }
+
     if (_onClick != nullptr && isMouseHover())
-        _onClick->exec();
+        TaskScheduler::run(_onClick);
+}
+
+void Component::onClick(const Point& point) {
+    const Point* previous = _clickPoint;
+
+    // Overrides of onClick() and isMouseHover() see the event's position
+    _clickPoint = &point;
+
+    try {
+        onClick();
+    }
+    catch (...) {
+        _clickPoint = previous;
+        throw;
+    }
+
+    _clickPoint = previous;
 }
 
 void Component::onHover() {
     if (_onHover != nullptr)
-        _onHover->exec();
+        TaskScheduler::run(_onHover);
+}
+
+void Component::onHoverEnter() {
+    onHover();
+}
+
+void Component::onHoverLeave() {
+    if (_onHoverLeave != nullptr)
+        TaskScheduler::run(_onHoverLeave);
+}
+
+bool Component::buildGeometry(Geometry&) const {
+    return false;
 }
 
 void Component::setContainer(
@@ -46,6 +153,37 @@ void Component::setContainer(
     _container = container;
 }
 
+void Component::markDirty() {
+    _dirty = true;
+    _boundsValid = false;
+
+    for (ComponentObserver* observer : _observers)
+        observer->onComponentUpdate(*this);
+}
+
+void Component::addObserver(ComponentObserver* observer) {
+    if (observer == nullptr)
+        return;
+
+    if (::std::find(_observers.begin(), _observers.end(), observer) ==
+        _observers.end())
+        _observers.push_back(observer);
+}
+
+void Component::removeObserver(ComponentObserver* observer) {
+    _observers.erase(
+        ::std::remove(_observers.begin(), _observers.end(), observer),
+        _observers.end());
+}
+
+bool Component::isDirty() const {
+    return _dirty;
+}
+
+void Component::clearDirty() {
+    _dirty = false;
+}
+
 void Component::setOnClickAction(void (*action)()) {
     _onClick = ::std::make_shared<Component::DeprecatedTask>(action);
 }
@@ -55,7 +193,11 @@ void Component::setOnClickAction(const std::shared_ptr<Task>& action) {
 }
 
 void Component::setOnHoverAction(const std::shared_ptr<Task>& action) {
-    _onClick = action;
+    _onHover = action;
+}
+
+void Component::setOnHoverLeaveAction(const std::shared_ptr<Task>& action) {
+    _onHoverLeave = action;
 }
 
 void Component::setOnHoverAction(void (*action)()) {
@@ -0,0 +1,510 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file ConstraintLayout.cpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Implementation of the ConstraintLayout class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <ConstraintLayout.hpp>
+
+namespace easyGUI {
+
+// Smallest change of a quantity worth a new solution or a move
+static constexpr double LAYOUT_EPSILON = 1.0e-3;
+
+// Anchors may outlive the layout when they are destroyed at exit
+static ConstraintLayout* liveLayout = nullptr;
+
+static bool hasChanged(const double& previous, const double& current) {
+    return ::std::abs(previous - current) > LAYOUT_EPSILON;
+}
+
+ConstraintLayout::ConstraintLayout() {
+    _windowLeft = _solver.createVariable();
+    _windowTop = _solver.createVariable();
+    _windowWidth = _solver.createVariable();
+    _windowHeight = _solver.createVariable();
+    _owners.resize(_windowHeight.id + 1);
+
+    _solver.addEditVariable(_windowLeft, STRENGTH_STRONG);
+    _solver.addEditVariable(_windowTop, STRENGTH_STRONG);
+    _solver.addEditVariable(_windowWidth, STRENGTH_STRONG);
+    _solver.addEditVariable(_windowHeight, STRENGTH_STRONG);
+
+    liveLayout = this;
+}
+
+ConstraintLayout::~ConstraintLayout() {
+    // Components may outlive the layout when they are destroyed at exit
+    for (auto& element : _entries) {
+        if (element.second.target)
+            element.second.target->removeObserver(this);
+    }
+
+    liveLayout = nullptr;
+}
+
+ConstraintLayout& ConstraintLayout::getInstance() {
+    static ConstraintLayout _instance;
+
+    return _instance;
+}
+
+ConstraintLayout* ConstraintLayout::getLiveInstance() {
+    return liveLayout;
+}
+
+Expression ConstraintLayout::getExpression(Anchor* anchor,
+                                           const LayoutAttribute& attribute) {
+    if (!anchor) {
+        ERROR << "[ConstraintLayout] Cannot constrain a null anchor\n";
+        return Expression();
+    }
+
+    return getExpression(getEntry(anchor), attribute);
+}
+
+Expression ConstraintLayout::getWindowExpression(
+    const LayoutAttribute& attribute) const {
+    switch (attribute) {
+        case ATTRIBUTE_LEFT:
+            return Expression(_windowLeft);
+        case ATTRIBUTE_RIGHT:
+            return Expression(_windowLeft).add(_windowWidth);
+        case ATTRIBUTE_TOP:
+            return Expression(_windowTop);
+        case ATTRIBUTE_BOTTOM:
+            return Expression(_windowTop).add(_windowHeight);
+        case ATTRIBUTE_CENTER_X:
+            return Expression(_windowLeft).add(_windowWidth, 0.5);
+        case ATTRIBUTE_CENTER_Y:
+            return Expression(_windowTop).add(_windowHeight, 0.5);
+        case ATTRIBUTE_WIDTH:
+            return Expression(_windowWidth);
+        case ATTRIBUTE_HEIGHT:
+        default:
+            return Expression(_windowHeight);
+    }
+}
+
+ConstraintId ConstraintLayout::addConstraint(const Expression& expression,
+                                             const Relation& relation,
+                                             const double& strength) {
+    return addGroup({expression}, relation, strength);
+}
+
+ConstraintId ConstraintLayout::addBinding(Anchor* source,
+                                          Anchor* anchor,
+                                          const BindingPoint& sourcePoint,
+                                          const BindingPoint& anchorPoint,
+                                          const Point& offset,
+                                          const double& strength) {
+    if (!source || !anchor || source == anchor) {
+        ERROR << "[ConstraintLayout] Cannot bind these elements\n";
+        return INVALID_CONSTRAINT;
+    }
+
+    Expression x = getPointX(source, sourcePoint) -
+                   getPointX(anchor, anchorPoint) - offset.Xcoord;
+    Expression y = getPointY(source, sourcePoint) -
+                   getPointY(anchor, anchorPoint) - offset.Ycoord;
+
+    return addGroup({x, y}, EQUAL, strength);
+}
+
+bool ConstraintLayout::removeConstraint(const ConstraintId& constraint) {
+    auto group = _groups.find(constraint);
+
+    if (group == _groups.end())
+        return false;
+
+    for (const ConstraintId& part : group->second.constraints)
+        _solver.removeConstraint(part);
+
+    for (const Variable& variable : group->second.variables) {
+        const Owner& owner = _owners[variable.id];
+        auto entry = _entries.find(owner.anchor);
+
+        if (entry == _entries.end())
+            continue;
+
+        ::std::vector<ConstraintId>& list = entry->second.constraints;
+
+        // A position no constraint refers to anymore is left alone again
+        if (--entry->second.uses[owner.quantity] == 0 &&
+            owner.quantity < QUANTITY_WIDTH && entry->second.target)
+            _solver.removeEditVariable(variable);
+
+        list.erase(::std::remove(list.begin(), list.end(), constraint),
+                   list.end());
+    }
+
+    _groups.erase(group);
+
+    return true;
+}
+
+void ConstraintLayout::remove(const Anchor* anchor) {
+    auto entry = _entries.find(anchor);
+
+    if (entry == _entries.end())
+        return;
+
+    // Copied, since removing a constraint alters the list
+    const ::std::vector<ConstraintId> constraints = entry->second.constraints;
+
+    for (const ConstraintId& constraint : constraints)
+        removeConstraint(constraint);
+
+    if (entry->second.target) {
+        entry->second.target->removeObserver(this);
+        _targets.erase(entry->second.target);
+    }
+
+    _changed.erase(anchor);
+    _unobserved.erase(anchor);
+    _outdated.erase(anchor);
+
+    // The slots of the variables are reused by the next anchors
+    for (const Variable& variable : entry->second.variables) {
+        _solver.removeEditVariable(variable);
+        _solver.releaseVariable(variable);
+        _owners[variable.id] = Owner();
+    }
+
+    _entries.erase(entry);
+}
+
+void ConstraintLayout::setWindowArea(const ::sf::FloatRect& area) {
+    _solver.suggestValue(_windowLeft, area.left);
+    _solver.suggestValue(_windowTop, area.top);
+    _solver.suggestValue(_windowWidth, area.width);
+    _solver.suggestValue(_windowHeight, area.height);
+}
+
+size_t ConstraintLayout::update() {
+    size_t moved = 0;
+
+    // Swapped out, since moving the components queues them again
+    ::std::unordered_set<const Anchor*> queued;
+
+    queued.swap(_changed);
+
+    // The measured quantities are suggested first, so that the solution
+    // is up to date before anything moves
+    for (const Anchor* anchor : queued)
+        remeasure(anchor);
+
+    for (const Anchor* anchor : _unobserved)
+        remeasure(anchor);
+
+    // Only the elements whose variables changed are read back
+    ::std::vector<Variable> variables;
+
+    _solver.takeChangedVariables(variables);
+
+    for (const Variable& variable : variables) {
+        if (variable.id < _owners.size() && _owners[variable.id].anchor)
+            _outdated.insert(_owners[variable.id].anchor);
+    }
+
+    ::std::unordered_set<const Anchor*> outdated;
+
+    outdated.swap(_outdated);
+
+    for (const Anchor* anchor : outdated) {
+        auto found = _entries.find(anchor);
+
+        if (found == _entries.end() || !found->second.target)
+            continue;
+
+        Entry& entry = found->second;
+
+        double location[2] = {entry.values[QUANTITY_LEFT],
+                              entry.values[QUANTITY_TOP]};
+        bool changed = false;
+
+        for (int quantity = QUANTITY_LEFT; quantity <= QUANTITY_TOP;
+             ++quantity) {
+            // Axes that no constraint refers to are left alone
+            if (entry.uses[quantity] == 0)
+                continue;
+
+            const double value =
+                _solver.getValue(entry.variables[quantity]);
+
+            if (!hasChanged(entry.values[quantity], value))
+                continue;
+
+            entry.values[quantity] = value;
+            location[quantity] = value;
+            changed = true;
+        }
+
+        if (!changed)
+            continue;
+
+        // The other axis keeps its current position
+        if (entry.uses[QUANTITY_LEFT] == 0)
+            location[QUANTITY_LEFT] = entry.anchor->getLEFT().Xcoord;
+
+        if (entry.uses[QUANTITY_TOP] == 0)
+            location[QUANTITY_TOP] = entry.anchor->getTOP().Ycoord;
+
+        entry.target->updateLocation(Point(location[QUANTITY_LEFT],
+                                           location[QUANTITY_TOP]));
+        moved++;
+    }
+
+    return moved;
+}
+
+size_t ConstraintLayout::getConstraintCount() const {
+    return _groups.size();
+}
+
+void ConstraintLayout::onComponentUpdate(Component& component) {
+    auto found = _targets.find(&component);
+
+    if (found != _targets.end())
+        _changed.insert(found->second);
+}
+
+void ConstraintLayout::onComponentDestroyed(Component& component) {
+    auto found = _targets.find(&component);
+
+    if (found == _targets.end())
+        return;
+
+    // The anchor removes its entry once it is destroyed as well
+    auto entry = _entries.find(found->second);
+
+    if (entry != _entries.end())
+        entry->second.target = nullptr;
+
+    _changed.erase(found->second);
+    _outdated.erase(found->second);
+    _targets.erase(found);
+}
+
+ConstraintLayout::Entry& ConstraintLayout::getEntry(Anchor* anchor) {
+    auto found = _entries.find(anchor);
+
+    if (found != _entries.end())
+        return found->second;
+
+    Entry& entry = _entries[anchor];
+
+    entry.anchor = anchor;
+    entry.target = anchor->toComponent();
+
+    if (entry.target) {
+        entry.target->addObserver(this);
+        _targets[entry.target] = anchor;
+    } else {
+        _unobserved.insert(anchor);
+    }
+
+    measure(*anchor, entry.values);
+
+    for (int quantity = 0; quantity < QUANTITY_COUNT; ++quantity) {
+        const Variable variable = _solver.createVariable();
+
+        entry.variables[quantity] = variable;
+
+        if (_owners.size() <= variable.id)
+            _owners.resize(variable.id + 1);
+
+        _owners[variable.id].anchor = anchor;
+        _owners[variable.id].quantity = static_cast<Quantity>(quantity);
+
+        // Sizes follow the bounds, and so do the positions of the anchors
+        // which are not moved by the layout
+        if (quantity >= QUANTITY_WIDTH || !entry.target) {
+            _solver.addEditVariable(variable, STRENGTH_STRONG);
+            _solver.suggestValue(variable, entry.values[quantity]);
+        }
+    }
+
+    return entry;
+}
+
+void ConstraintLayout::remeasure(const Anchor* anchor) {
+    auto found = _entries.find(anchor);
+
+    if (found == _entries.end())
+        return;
+
+    Entry& entry = found->second;
+    double values[QUANTITY_COUNT];
+
+    measure(*entry.anchor, values);
+
+    for (int quantity = 0; quantity < QUANTITY_COUNT; ++quantity) {
+        const Variable& variable = entry.variables[quantity];
+
+        if (!hasChanged(entry.values[quantity], values[quantity]))
+            continue;
+
+        // Kept for the positions which stay once they are constrained
+        entry.values[quantity] = values[quantity];
+
+        if (_solver.hasEditVariable(variable))
+            _solver.suggestValue(variable, values[quantity]);
+    }
+}
+
+void ConstraintLayout::measure(const Anchor& anchor, double* values) const {
+    const double left = anchor.getLEFT().Xcoord;
+    const double top = anchor.getTOP().Ycoord;
+
+    values[QUANTITY_LEFT] = left;
+    values[QUANTITY_TOP] = top;
+    values[QUANTITY_WIDTH] = anchor.getRIGHT().Xcoord - left;
+    values[QUANTITY_HEIGHT] = anchor.getBOTTOM().Ycoord - top;
+}
+
+Expression ConstraintLayout::getExpression(
+    const Entry& entry, const LayoutAttribute& attribute) const {
+    const Variable& left = entry.variables[QUANTITY_LEFT];
+    const Variable& top = entry.variables[QUANTITY_TOP];
+    const Variable& width = entry.variables[QUANTITY_WIDTH];
+    const Variable& height = entry.variables[QUANTITY_HEIGHT];
+
+    switch (attribute) {
+        case ATTRIBUTE_LEFT:
+            return Expression(left);
+        case ATTRIBUTE_RIGHT:
+            return Expression(left).add(width);
+        case ATTRIBUTE_TOP:
+            return Expression(top);
+        case ATTRIBUTE_BOTTOM:
+            return Expression(top).add(height);
+        case ATTRIBUTE_CENTER_X:
+            return Expression(left).add(width, 0.5);
+        case ATTRIBUTE_CENTER_Y:
+            return Expression(top).add(height, 0.5);
+        case ATTRIBUTE_WIDTH:
+            return Expression(width);
+        case ATTRIBUTE_HEIGHT:
+        default:
+            return Expression(height);
+    }
+}
+
+Expression ConstraintLayout::getPointX(Anchor* anchor,
+                                       const BindingPoint& point) {
+    switch (point) {
+        case BindingPoint::LEFT:
+            return getExpression(anchor, ATTRIBUTE_LEFT);
+        case BindingPoint::RIGHT:
+            return getExpression(anchor, ATTRIBUTE_RIGHT);
+        case BindingPoint::TOP:
+        case BindingPoint::BOTTOM:
+        case BindingPoint::CENTER:
+        default:
+            return getExpression(anchor, ATTRIBUTE_CENTER_X);
+    }
+}
+
+Expression ConstraintLayout::getPointY(Anchor* anchor,
+                                       const BindingPoint& point) {
+    switch (point) {
+        case BindingPoint::TOP:
+            return getExpression(anchor, ATTRIBUTE_TOP);
+        case BindingPoint::BOTTOM:
+            return getExpression(anchor, ATTRIBUTE_BOTTOM);
+        case BindingPoint::LEFT:
+        case BindingPoint::RIGHT:
+        case BindingPoint::CENTER:
+        default:
+            return getExpression(anchor, ATTRIBUTE_CENTER_Y);
+    }
+}
+
+ConstraintId ConstraintLayout::addGroup(
+    const ::std::vector<Expression>& expressions,
+    const Relation& relation,
+    const double& strength) {
+    Group group;
+
+    for (const Expression& expression : expressions) {
+        const ConstraintId part =
+            _solver.addConstraint(expression, relation, strength);
+
+        if (part == INVALID_CONSTRAINT) {
+            // The constraints are added all together or not at all
+            for (const ConstraintId& added : group.constraints)
+                _solver.removeConstraint(added);
+
+            return INVALID_CONSTRAINT;
+        }
+
+        group.constraints.push_back(part);
+
+        for (const Expression::Term& term : expression.getTerms())
+            group.variables.push_back(term.variable);
+    }
+
+    const ConstraintId constraint = _nextGroup++;
+
+    for (const Variable& variable : group.variables) {
+        if (variable.id >= _owners.size())
+            continue;
+
+        const Owner& owner = _owners[variable.id];
+        auto entry = _entries.find(owner.anchor);
+
+        if (entry == _entries.end())
+            continue;
+
+        ::std::vector<ConstraintId>& list = entry->second.constraints;
+
+        // Constrained axes may have to move even if no value changed
+        entry->second.uses[owner.quantity]++;
+        _outdated.insert(owner.anchor);
+
+        // The positions the constraints leave undecided weakly stay where
+        // they were measured instead of snapping to 0. The stay is added
+        // after the constraint, which is cheaper to solve than the reverse.
+        if (!_solver.hasEditVariable(variable)) {
+            _solver.addEditVariable(variable, STRENGTH_WEAK);
+            _solver.suggestValue(variable,
+                                 entry->second.values[owner.quantity]);
+        }
+
+        if (list.empty() || list.back() != constraint)
+            list.push_back(constraint);
+    }
+
+    _groups[constraint] = ::std::move(group);
+
+    return constraint;
+}
+
+}  // namespace easyGUI
@@ -0,0 +1,975 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file ConstraintSolver.cpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Implementation of the ConstraintSolver class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include <ConstraintSolver.hpp>
+
+namespace easyGUI {
+
+static bool nearZero(const double& value) {
+    return value < 1.0e-8 && value > -1.0e-8;
+}
+
+static double clipStrength(const double& strength) {
+    return ::std::max(0.0, ::std::min(STRENGTH_REQUIRED, strength));
+}
+
+// ----- Expression -----
+
+Expression::Expression(const double& constant) : _constant(constant) {}
+
+Expression::Expression(const Variable& variable, const double& coefficient) {
+    add(variable, coefficient);
+}
+
+Expression& Expression::add(const Variable& variable,
+                            const double& coefficient) {
+    _terms.push_back(Term{variable, coefficient});
+
+    return *this;
+}
+
+Expression& Expression::add(const Expression& other,
+                            const double& coefficient) {
+    for (const Term& term : other._terms)
+        _terms.push_back(Term{term.variable, term.coefficient * coefficient});
+
+    _constant += other._constant * coefficient;
+
+    return *this;
+}
+
+Expression& Expression::add(const double& constant) {
+    _constant += constant;
+
+    return *this;
+}
+
+Expression Expression::operator+ (const Expression& other) const {
+    return Expression(*this).add(other);
+}
+
+Expression Expression::operator- (const Expression& other) const {
+    return Expression(*this).add(other, -1.0);
+}
+
+Expression Expression::operator+ (const double& constant) const {
+    return Expression(*this).add(constant);
+}
+
+Expression Expression::operator- (const double& constant) const {
+    return Expression(*this).add(-constant);
+}
+
+Expression Expression::operator* (const double& factor) const {
+    return Expression().add(*this, factor);
+}
+
+const ::std::vector<Expression::Term>& Expression::getTerms() const {
+    return _terms;
+}
+
+double Expression::getConstant() const {
+    return _constant;
+}
+
+// ----- Rows -----
+
+::std::vector<ConstraintSolver::Cell>::iterator
+ConstraintSolver::Row::locate(const Symbol& symbol) {
+    return ::std::lower_bound(cells.begin(), cells.end(), symbol,
+        [](const Cell& cell, const Symbol& value) {
+            return cell.symbol < value;
+    });
+}
+
+::std::vector<ConstraintSolver::Cell>::const_iterator
+ConstraintSolver::Row::locate(const Symbol& symbol) const {
+    return ::std::lower_bound(cells.begin(), cells.end(), symbol,
+        [](const Cell& cell, const Symbol& value) {
+            return cell.symbol < value;
+    });
+}
+
+double ConstraintSolver::Row::coefficientFor(const Symbol& symbol) const {
+    auto it = locate(symbol);
+
+    if (it == cells.end() || it->symbol != symbol)
+        return 0.0;
+
+    return it->coefficient;
+}
+
+double ConstraintSolver::Row::add(const double& value) {
+    constant += value;
+
+    return constant;
+}
+
+void ConstraintSolver::Row::insert(const Symbol& symbol,
+                                   const double& coefficient) {
+    auto it = locate(symbol);
+
+    if (it != cells.end() && it->symbol == symbol) {
+        it->coefficient += coefficient;
+
+        if (nearZero(it->coefficient))
+            cells.erase(it);
+    } else if (!nearZero(coefficient)) {
+        cells.insert(it, Cell{symbol, coefficient});
+    }
+}
+
+void ConstraintSolver::Row::insert(const Row& other,
+                                   const double& coefficient) {
+    constant += other.constant * coefficient;
+
+    for (const Cell& cell : other.cells)
+        insert(cell.symbol, cell.coefficient * coefficient);
+}
+
+void ConstraintSolver::Row::remove(const Symbol& symbol) {
+    auto it = locate(symbol);
+
+    if (it != cells.end() && it->symbol == symbol)
+        cells.erase(it);
+}
+
+void ConstraintSolver::Row::reverseSign() {
+    constant = -constant;
+
+    for (Cell& cell : cells)
+        cell.coefficient = -cell.coefficient;
+}
+
+void ConstraintSolver::Row::solveFor(const Symbol& symbol) {
+    auto it = locate(symbol);
+    const double coefficient = -1.0 / it->coefficient;
+
+    cells.erase(it);
+    constant *= coefficient;
+
+    for (Cell& cell : cells)
+        cell.coefficient *= coefficient;
+}
+
+void ConstraintSolver::Row::solveFor(const Symbol& lhs, const Symbol& rhs) {
+    insert(lhs, -1.0);
+    solveFor(rhs);
+}
+
+bool ConstraintSolver::Row::substitute(const Symbol& symbol,
+                                       const Row& other) {
+    auto it = locate(symbol);
+
+    if (it == cells.end() || it->symbol != symbol)
+        return false;
+
+    const double coefficient = it->coefficient;
+
+    cells.erase(it);
+    insert(other, coefficient);
+
+    return true;
+}
+
+// ----- Solver -----
+
+ConstraintSolver::ConstraintSolver() {
+    reset();
+}
+
+void ConstraintSolver::reset() {
+    _types.assign(1, SYMBOL_INVALID);
+    _variables.assign(1, INVALID_SYMBOL);
+    _freeSymbols.clear();
+    _freeVariables.clear();
+    _externals.clear();
+    _changed.clear();
+
+    _rows.clear();
+    _columns.clear();
+    _objective = Row();
+    _artificial.reset();
+    _infeasible.clear();
+
+    _constraints.clear();
+    _edits.clear();
+    _nextConstraint = INVALID_CONSTRAINT + 1;
+}
+
+Variable ConstraintSolver::createVariable() {
+    Variable variable;
+    const Symbol symbol = newSymbol(SYMBOL_EXTERNAL);
+
+    if (!_freeVariables.empty()) {
+        variable.id = _freeVariables.back();
+        _freeVariables.pop_back();
+        _variables[variable.id] = symbol;
+    } else {
+        variable.id = static_cast<uint32_t>(_variables.size());
+        _variables.push_back(symbol);
+    }
+
+    if (_externals.size() <= symbol)
+        _externals.resize(symbol + 1);
+
+    _externals[symbol] = variable.id;
+
+    return variable;
+}
+
+bool ConstraintSolver::releaseVariable(const Variable& variable) {
+    if (!isValid(variable))
+        return false;
+
+    const Symbol symbol = _variables[variable.id];
+
+    if (hasEditVariable(variable) || _rows.count(symbol) > 0 ||
+        _columns.count(symbol) > 0) {
+        ERROR << "[ConstraintSolver] Cannot release a variable which is "
+              << "still in use\n";
+        return false;
+    }
+
+    _objective.remove(symbol);
+    freeSymbol(symbol);
+
+    _externals[symbol] = 0;
+    _changed.erase(variable.id);
+    _variables[variable.id] = INVALID_SYMBOL;
+    _freeVariables.push_back(variable.id);
+
+    return true;
+}
+
+double ConstraintSolver::getValue(const Variable& variable) const {
+    if (!isValid(variable))
+        return 0.0;
+
+    // Variables outside the basis are zero
+    auto it = _rows.find(_variables[variable.id]);
+
+    return it == _rows.end() ? 0.0 : it->second.constant;
+}
+
+ConstraintId ConstraintSolver::addConstraint(const Expression& expression,
+                                             const Relation& relation,
+                                             const double& strength) {
+    for (const Expression::Term& term : expression.getTerms()) {
+        if (!isValid(term.variable)) {
+            ERROR << "[ConstraintSolver] The constraint uses an unknown "
+                  << "variable\n";
+            return INVALID_CONSTRAINT;
+        }
+    }
+
+    const double clipped = clipStrength(strength);
+
+    Tag tag;
+    Row row = createRow(expression, relation, clipped, tag);
+    Symbol subject = chooseSubject(row, tag);
+
+    if (subject == INVALID_SYMBOL && allDummies(row)) {
+        if (!nearZero(row.constant)) {
+            ERROR << "[ConstraintSolver] The constraint cannot be satisfied\n";
+            freeSymbol(tag.marker);
+            freeSymbol(tag.other);
+            return INVALID_CONSTRAINT;
+        }
+
+        subject = tag.marker;
+    }
+
+    if (subject == INVALID_SYMBOL) {
+        if (!addWithArtificialVariable(row)) {
+            // The row is dropped, and its symbols with it
+            ERROR << "[ConstraintSolver] The constraint cannot be satisfied\n";
+            freeSymbol(tag.marker);
+            freeSymbol(tag.other);
+            return INVALID_CONSTRAINT;
+        }
+    } else {
+        row.solveFor(subject);
+        substitute(subject, row);
+        insertRow(subject, ::std::move(row));
+    }
+
+    const ConstraintId constraint = _nextConstraint++;
+
+    _constraints[constraint] = ConstraintInfo{tag, clipped};
+    optimize(_objective);
+
+    return constraint;
+}
+
+bool ConstraintSolver::removeConstraint(const ConstraintId& constraint) {
+    auto found = _constraints.find(constraint);
+
+    if (found == _constraints.end())
+        return false;
+
+    const Tag tag = found->second.tag;
+    const double strength = found->second.strength;
+
+    _constraints.erase(found);
+
+    if (_types[tag.marker] == SYMBOL_ERROR)
+        removeMarkerEffects(tag.marker, strength);
+
+    if (_types[tag.other] == SYMBOL_ERROR)
+        removeMarkerEffects(tag.other, strength);
+
+    auto it = _rows.find(tag.marker);
+
+    if (it != _rows.end()) {
+        extractRow(it);
+    } else {
+        // The marker is pivoted into the basis, taking its row along
+        it = getMarkerLeavingRow(tag.marker);
+
+        if (it == _rows.end()) {
+            ERROR << "[ConstraintSolver] Failed to remove a constraint\n";
+            return false;
+        }
+
+        const Symbol leaving = it->first;
+        Row row = extractRow(it);
+
+        row.solveFor(leaving, tag.marker);
+        substitute(tag.marker, row);
+    }
+
+    // Left in the tableau, the other symbol of the constraint would be
+    // free to grow and could make the objective unbounded
+    if (tag.other != INVALID_SYMBOL)
+        eraseSymbol(tag.other);
+
+    freeSymbol(tag.marker);
+    freeSymbol(tag.other);
+    optimize(_objective);
+
+    return true;
+}
+
+bool ConstraintSolver::hasConstraint(const ConstraintId& constraint) const {
+    return _constraints.count(constraint) > 0;
+}
+
+bool ConstraintSolver::addEditVariable(const Variable& variable,
+                                       const double& strength) {
+    if (!isValid(variable) || hasEditVariable(variable))
+        return false;
+
+    const double clipped = clipStrength(strength);
+
+    if (clipped >= STRENGTH_REQUIRED) {
+        ERROR << "[ConstraintSolver] Edit variables cannot be required\n";
+        return false;
+    }
+
+    const ConstraintId constraint =
+        addConstraint(Expression(variable), EQUAL, clipped);
+
+    if (constraint == INVALID_CONSTRAINT)
+        return false;
+
+    _edits[variable.id] = EditInfo{constraint,
+                                   _constraints[constraint].tag,
+                                   0.0};
+
+    return true;
+}
+
+bool ConstraintSolver::removeEditVariable(const Variable& variable) {
+    auto it = _edits.find(variable.id);
+
+    if (it == _edits.end())
+        return false;
+
+    removeConstraint(it->second.constraint);
+    _edits.erase(it);
+
+    return true;
+}
+
+bool ConstraintSolver::hasEditVariable(const Variable& variable) const {
+    return _edits.count(variable.id) > 0;
+}
+
+bool ConstraintSolver::suggestValue(const Variable& variable,
+                                    const double& value) {
+    auto found = _edits.find(variable.id);
+
+    if (found == _edits.end()) {
+        ERROR << "[ConstraintSolver] The variable is not editable\n";
+        return false;
+    }
+
+    EditInfo& info = found->second;
+    const double delta = value - info.constant;
+
+    info.constant = value;
+
+    if (nearZero(delta))
+        return true;
+
+    // If one of the error symbols is basic, only its row changes
+    auto it = _rows.find(info.tag.marker);
+
+    if (it != _rows.end()) {
+        if (it->second.add(-delta) < 0.0)
+            _infeasible.push_back(it->first);
+
+        return dualOptimize();
+    }
+
+    it = _rows.find(info.tag.other);
+
+    if (it != _rows.end()) {
+        if (it->second.add(delta) < 0.0)
+            _infeasible.push_back(it->first);
+
+        return dualOptimize();
+    }
+
+    // Otherwise, the rows which contain the marker are updated
+    auto column = _columns.find(info.tag.marker);
+
+    if (column != _columns.end()) {
+        for (const Symbol& basic : column->second) {
+            Row& row = _rows.find(basic)->second;
+            const double coefficient = row.coefficientFor(info.tag.marker);
+
+            if (row.add(delta * coefficient) < 0.0 &&
+                _types[basic] != SYMBOL_EXTERNAL)
+                _infeasible.push_back(basic);
+
+            markChanged(basic);
+        }
+    }
+
+    return dualOptimize();
+}
+
+size_t ConstraintSolver::getConstraintCount() const {
+    return _constraints.size();
+}
+
+void ConstraintSolver::takeChangedVariables(
+    ::std::vector<Variable>& variables) {
+    for (const uint32_t& id : _changed) {
+        Variable variable;
+
+        variable.id = id;
+        variables.push_back(variable);
+    }
+
+    _changed.clear();
+}
+
+bool ConstraintSolver::isValid(const Variable& variable) const {
+    return variable.id != 0 && variable.id < _variables.size() &&
+           _variables[variable.id] != INVALID_SYMBOL;
+}
+
+bool ConstraintSolver::isPivotable(const Symbol& symbol) const {
+    return _types[symbol] == SYMBOL_SLACK || _types[symbol] == SYMBOL_ERROR;
+}
+
+ConstraintSolver::Symbol ConstraintSolver::newSymbol(const SymbolType& type) {
+    if (!_freeSymbols.empty()) {
+        const Symbol symbol = _freeSymbols.back();
+
+        _freeSymbols.pop_back();
+        _types[symbol] = type;
+
+        return symbol;
+    }
+
+    _types.push_back(type);
+
+    return static_cast<Symbol>(_types.size() - 1);
+}
+
+void ConstraintSolver::freeSymbol(const Symbol& symbol) {
+    if (symbol == INVALID_SYMBOL)
+        return;
+
+    _types[symbol] = SYMBOL_INVALID;
+    _freeSymbols.push_back(symbol);
+}
+
+void ConstraintSolver::markChanged(const Symbol& basic) {
+    // Only the values of external symbols are ever read
+    if (_types[basic] == SYMBOL_EXTERNAL)
+        _changed.insert(_externals[basic]);
+}
+
+void ConstraintSolver::insertRow(const Symbol& basic, Row&& row) {
+    for (const Cell& cell : row.cells) {
+        if (_types[cell.symbol] != SYMBOL_DUMMY)
+            _columns[cell.symbol].insert(basic);
+    }
+
+    markChanged(basic);
+    _rows[basic] = ::std::move(row);
+}
+
+ConstraintSolver::Row ConstraintSolver::extractRow(RowMap::iterator it) {
+    const Symbol basic = it->first;
+    Row row = ::std::move(it->second);
+
+    _rows.erase(it);
+    markChanged(basic);
+
+    for (const Cell& cell : row.cells)
+        eraseFromColumn(cell.symbol, basic);
+
+    return row;
+}
+
+void ConstraintSolver::eraseSymbol(const Symbol& symbol) {
+    auto it = _rows.find(symbol);
+
+    // A basic symbol is only defined by its own row
+    if (it != _rows.end()) {
+        extractRow(it);
+        return;
+    }
+
+    // Otherwise it is zero, so dropping it keeps the solution
+    for (const Symbol& basic : findRows(symbol))
+        _rows.find(basic)->second.remove(symbol);
+
+    _columns.erase(symbol);
+    _objective.remove(symbol);
+}
+
+void ConstraintSolver::eraseFromColumn(const Symbol& symbol,
+                                       const Symbol& basic) {
+    if (_types[symbol] == SYMBOL_DUMMY)
+        return;
+
+    auto column = _columns.find(symbol);
+
+    if (column == _columns.end())
+        return;
+
+    column->second.erase(basic);
+
+    if (column->second.empty())
+        _columns.erase(column);
+}
+
+::std::vector<ConstraintSolver::Symbol> ConstraintSolver::findRows(
+    const Symbol& symbol) const {
+    ::std::vector<Symbol> basics;
+
+    if (_types[symbol] == SYMBOL_DUMMY) {
+        // Dummy symbols are not indexed
+        for (const auto& entry : _rows) {
+            if (entry.second.coefficientFor(symbol) != 0.0)
+                basics.push_back(entry.first);
+        }
+
+        return basics;
+    }
+
+    auto column = _columns.find(symbol);
+
+    if (column != _columns.end())
+        basics.assign(column->second.begin(), column->second.end());
+
+    return basics;
+}
+
+ConstraintSolver::Row ConstraintSolver::createRow(const Expression& expression,
+                                                  const Relation& relation,
+                                                  const double& strength,
+                                                  Tag& tag) {
+    Row row;
+
+    row.constant = expression.getConstant();
+
+    // Basic variables are replaced by their rows
+    for (const Expression::Term& term : expression.getTerms()) {
+        if (nearZero(term.coefficient))
+            continue;
+
+        const Symbol symbol = _variables[term.variable.id];
+        auto it = _rows.find(symbol);
+
+        if (it != _rows.end())
+            row.insert(it->second, term.coefficient);
+        else
+            row.insert(symbol, term.coefficient);
+    }
+
+    switch (relation) {
+        case LESS_EQUAL:
+        case GREATER_EQUAL: {
+            const double coefficient = relation == LESS_EQUAL ? 1.0 : -1.0;
+            const Symbol slack = newSymbol(SYMBOL_SLACK);
+
+            tag.marker = slack;
+            row.insert(slack, coefficient);
+
+            if (strength < STRENGTH_REQUIRED) {
+                const Symbol error = newSymbol(SYMBOL_ERROR);
+
+                tag.other = error;
+                row.insert(error, -coefficient);
+                _objective.insert(error, strength);
+            }
+            break;
+        }
+        case EQUAL:
+            if (strength < STRENGTH_REQUIRED) {
+                const Symbol plus = newSymbol(SYMBOL_ERROR);
+                const Symbol minus = newSymbol(SYMBOL_ERROR);
+
+                tag.marker = plus;
+                tag.other = minus;
+                row.insert(plus, -1.0);
+                row.insert(minus, 1.0);
+                _objective.insert(plus, strength);
+                _objective.insert(minus, strength);
+            } else {
+                const Symbol dummy = newSymbol(SYMBOL_DUMMY);
+
+                tag.marker = dummy;
+                row.insert(dummy, 1.0);
+            }
+            break;
+        default:
+            break;
+    }
+
+    // The constants of the rows are kept positive
+    if (row.constant < 0.0)
+        row.reverseSign();
+
+    return row;
+}
+
+ConstraintSolver::Symbol ConstraintSolver::chooseSubject(
+    const Row& row, const Tag& tag) const {
+    for (const Cell& cell : row.cells) {
+        if (_types[cell.symbol] == SYMBOL_EXTERNAL)
+            return cell.symbol;
+    }
+
+    if (isPivotable(tag.marker) && row.coefficientFor(tag.marker) < 0.0)
+        return tag.marker;
+
+    if (isPivotable(tag.other) && row.coefficientFor(tag.other) < 0.0)
+        return tag.other;
+
+    return INVALID_SYMBOL;
+}
+
+ConstraintSolver::Symbol ConstraintSolver::anyPivotableSymbol(
+    const Row& row) const {
+    for (const Cell& cell : row.cells) {
+        if (isPivotable(cell.symbol))
+            return cell.symbol;
+    }
+
+    return INVALID_SYMBOL;
+}
+
+bool ConstraintSolver::allDummies(const Row& row) const {
+    for (const Cell& cell : row.cells) {
+        if (_types[cell.symbol] != SYMBOL_DUMMY)
+            return false;
+    }
+
+    return true;
+}
+
+bool ConstraintSolver::addWithArtificialVariable(const Row& row) {
+    const Symbol artificial = newSymbol(SYMBOL_SLACK);
+
+    insertRow(artificial, Row(row));
+    _artificial.reset(new Row(row));
+
+    optimize(*_artificial);
+
+    const bool success = nearZero(_artificial->constant);
+
+    _artificial.reset();
+
+    auto it = _rows.find(artificial);
+
+    if (it != _rows.end()) {
+        Row basic = extractRow(it);
+
+        // A failed row is dropped, leaving the tableau as it was
+        if (basic.cells.empty() || !success) {
+            freeSymbol(artificial);
+            return success;
+        }
+
+        const Symbol entering = anyPivotableSymbol(basic);
+
+        if (entering == INVALID_SYMBOL) {
+            freeSymbol(artificial);
+            return false;
+        }
+
+        basic.solveFor(artificial, entering);
+        substitute(entering, basic);
+        insertRow(entering, ::std::move(basic));
+    }
+
+    auto column = _columns.find(artificial);
+
+    if (column != _columns.end()) {
+        for (const Symbol& other : column->second)
+            _rows.find(other)->second.remove(artificial);
+
+        _columns.erase(column);
+    }
+
+    _objective.remove(artificial);
+    freeSymbol(artificial);
+
+    return success;
+}
+
+void ConstraintSolver::substitute(const Symbol& symbol, const Row& row) {
+    // The symbol leaves all of these rows
+    const ::std::vector<Symbol> basics = findRows(symbol);
+
+    _columns.erase(symbol);
+
+    for (const Symbol& basic : basics) {
+        Row& target = _rows.find(basic)->second;
+
+        target.substitute(symbol, row);
+
+        for (const Cell& cell : row.cells) {
+            if (_types[cell.symbol] == SYMBOL_DUMMY)
+                continue;
+
+            if (target.coefficientFor(cell.symbol) != 0.0)
+                _columns[cell.symbol].insert(basic);
+            else
+                eraseFromColumn(cell.symbol, basic);
+        }
+
+        if (_types[basic] != SYMBOL_EXTERNAL && target.constant < 0.0)
+            _infeasible.push_back(basic);
+
+        markChanged(basic);
+    }
+
+    _objective.substitute(symbol, row);
+
+    if (_artificial)
+        _artificial->substitute(symbol, row);
+}
+
+bool ConstraintSolver::optimize(Row& objective) {
+    while (true) {
+        const Symbol entering = getEnteringSymbol(objective);
+
+        if (entering == INVALID_SYMBOL)
+            return true;
+
+        auto it = getLeavingRow(entering);
+
+        if (it == _rows.end()) {
+            ERROR << "[ConstraintSolver] The objective is unbounded\n";
+            return false;
+        }
+
+        const Symbol leaving = it->first;
+        Row row = extractRow(it);
+
+        row.solveFor(leaving, entering);
+        substitute(entering, row);
+        insertRow(entering, ::std::move(row));
+    }
+}
+
+bool ConstraintSolver::dualOptimize() {
+    while (!_infeasible.empty()) {
+        const Symbol leaving = _infeasible.back();
+
+        _infeasible.pop_back();
+
+        auto it = _rows.find(leaving);
+
+        // The symbol may have been freed and reused since it was queued
+        if (it == _rows.end() || _types[leaving] == SYMBOL_EXTERNAL ||
+            nearZero(it->second.constant) || it->second.constant >= 0.0)
+            continue;
+
+        const Symbol entering = getDualEnteringSymbol(it->second);
+
+        if (entering == INVALID_SYMBOL) {
+            ERROR << "[ConstraintSolver] The layout became infeasible\n";
+            _infeasible.clear();
+            return false;
+        }
+
+        Row row = extractRow(it);
+
+        row.solveFor(leaving, entering);
+        substitute(entering, row);
+        insertRow(entering, ::std::move(row));
+    }
+
+    return true;
+}
+
+ConstraintSolver::Symbol ConstraintSolver::getEnteringSymbol(
+    const Row& objective) const {
+    for (const Cell& cell : objective.cells) {
+        // The errors cannot depend on free variables, so their coefficients
+        // in the objective are only rounding errors of the strengths
+        if (_types[cell.symbol] == SYMBOL_EXTERNAL && &objective == &_objective)
+            continue;
+
+        if (_types[cell.symbol] != SYMBOL_DUMMY && cell.coefficient < 0.0)
+            return cell.symbol;
+    }
+
+    return INVALID_SYMBOL;
+}
+
+ConstraintSolver::Symbol ConstraintSolver::getDualEnteringSymbol(
+    const Row& row) const {
+    Symbol entering = INVALID_SYMBOL;
+    double ratio = ::std::numeric_limits<double>::max();
+
+    for (const Cell& cell : row.cells) {
+        if (cell.coefficient <= 0.0 || _types[cell.symbol] == SYMBOL_DUMMY)
+            continue;
+
+        const double current =
+            _objective.coefficientFor(cell.symbol) / cell.coefficient;
+
+        if (current < ratio) {
+            ratio = current;
+            entering = cell.symbol;
+        }
+    }
+
+    return entering;
+}
+
+ConstraintSolver::RowMap::iterator ConstraintSolver::getLeavingRow(
+    const Symbol& entering) {
+    double ratio = ::std::numeric_limits<double>::max();
+    Symbol found = INVALID_SYMBOL;
+    auto column = _columns.find(entering);
+
+    if (column == _columns.end())
+        return _rows.end();
+
+    for (const Symbol& basic : column->second) {
+        if (_types[basic] == SYMBOL_EXTERNAL)
+            continue;
+
+        const Row& row = _rows.find(basic)->second;
+        const double coefficient = row.coefficientFor(entering);
+
+        if (coefficient >= 0.0)
+            continue;
+
+        const double current = -row.constant / coefficient;
+
+        if (current < ratio) {
+            ratio = current;
+            found = basic;
+        }
+    }
+
+    return found == INVALID_SYMBOL ? _rows.end() : _rows.find(found);
+}
+
+ConstraintSolver::RowMap::iterator ConstraintSolver::getMarkerLeavingRow(
+    const Symbol& marker) {
+    const double max = ::std::numeric_limits<double>::max();
+    double firstRatio = max;
+    double secondRatio = max;
+
+    Symbol first = INVALID_SYMBOL;
+    Symbol second = INVALID_SYMBOL;
+    Symbol third = INVALID_SYMBOL;
+
+    for (const Symbol& basic : findRows(marker)) {
+        const Row& row = _rows.find(basic)->second;
+        const double coefficient = row.coefficientFor(marker);
+
+        if (_types[basic] == SYMBOL_EXTERNAL) {
+            third = basic;
+        } else if (coefficient < 0.0) {
+            const double current = -row.constant / coefficient;
+
+            if (current < firstRatio) {
+                firstRatio = current;
+                first = basic;
+            }
+        } else {
+            const double current = row.constant / coefficient;
+
+            if (current < secondRatio) {
+                secondRatio = current;
+                second = basic;
+            }
+        }
+    }
+
+    if (first != INVALID_SYMBOL)
+        return _rows.find(first);
+
+    if (second != INVALID_SYMBOL)
+        return _rows.find(second);
+
+    return third == INVALID_SYMBOL ? _rows.end() : _rows.find(third);
+}
+
+void ConstraintSolver::removeMarkerEffects(const Symbol& marker,
+                                           const double& strength) {
+    auto it = _rows.find(marker);
+
+    if (it != _rows.end())
+        _objective.insert(it->second, -strength);
+    else
+        _objective.insert(marker, -strength);
+}
+
+}  // namespace easyGUI
@@ -33,32 +33,32 @@ namespace easyGUI {
 
 ::std::shared_ptr<Button>
     Converter::getButton(::std::shared_ptr<Component> asset) {
-    return ::std::dynamic_pointer_cast<Button>(asset);
+    return as<Button>(asset);
 }
 
 ::std::shared_ptr<Label>
     Converter::getLabel(::std::shared_ptr<Component> asset) {
-    return ::std::dynamic_pointer_cast<Label>(asset);
+    return as<Label>(asset);
 }
 
 ::std::shared_ptr<TextBox>
     Converter::getTextbox(::std::shared_ptr<Component> asset) {
-    return ::std::dynamic_pointer_cast<TextBox>(asset);
+    return as<TextBox>(asset);
 }
 
 ::std::shared_ptr<Image>
     Converter::getImage(::std::shared_ptr<Component> asset) {
-    return ::std::dynamic_pointer_cast<Image>(asset);
+    return as<Image>(asset);
 }
 
 ::std::shared_ptr<CheckBox>
     Converter::getCheckBox(::std::shared_ptr<Component> asset) {
-    return ::std::dynamic_pointer_cast<CheckBox>(asset);
+    return as<CheckBox>(asset);
 }
 
 ::std::shared_ptr<Separator>
     Converter::getSeparator(::std::shared_ptr<Component> asset) {
-    return ::std::dynamic_pointer_cast<Separator>(asset);
+    return as<Separator>(asset);
 }
 
 }  // namespace easyGUI
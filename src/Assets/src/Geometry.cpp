@@ -0,0 +1,408 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file Geometry.cpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Implementation of the Geometry class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <Geometry.hpp>
+
+namespace easyGUI {
+
+static ::sf::FloatRect merge(const ::sf::FloatRect& first,
+                             const ::sf::FloatRect& second) {
+    const float left = ::std::min(first.left, second.left);
+    const float top = ::std::min(first.top, second.top);
+    const float right = ::std::max(first.left + first.width,
+                                   second.left + second.width);
+    const float bottom = ::std::max(first.top + first.height,
+                                    second.top + second.height);
+
+    return ::sf::FloatRect(left, top, right - left, bottom - top);
+}
+
+static ::sf::Vector2f computeNormal(const ::sf::Vector2f& first,
+                                    const ::sf::Vector2f& second) {
+    ::sf::Vector2f normal(first.y - second.y, second.x - first.x);
+    const float length = ::std::sqrt(normal.x * normal.x +
+                                     normal.y * normal.y);
+
+    if (length > 0) {
+        normal.x /= length;
+        normal.y /= length;
+    }
+
+    return normal;
+}
+
+void Geometry::clear() {
+    _vertices.clear();
+    _primitives.clear();
+}
+
+void Geometry::beginPrimitive(const ::sf::Texture* texture,
+                              const ::sf::FloatRect& bounds) {
+    if (!_primitives.empty()) {
+        Primitive& last = _primitives.back();
+
+        if (!last.drawable && last.texture == texture) {
+            last.bounds = merge(last.bounds, bounds);
+            return;
+        }
+    }
+
+    Primitive primitive;
+
+    primitive.texture = texture;
+    primitive.first = static_cast<uint32_t>(_vertices.size());
+    primitive.bounds = bounds;
+
+    _primitives.push_back(primitive);
+}
+
+void Geometry::addTriangle(const ::sf::Vertex& first,
+                           const ::sf::Vertex& second,
+                           const ::sf::Vertex& third) {
+    _vertices.push_back(first);
+    _vertices.push_back(second);
+    _vertices.push_back(third);
+
+    _primitives.back().count += 3;
+}
+
+void Geometry::addQuad(const ::sf::Vertex& topLeft,
+                       const ::sf::Vertex& topRight,
+                       const ::sf::Vertex& bottomRight,
+                       const ::sf::Vertex& bottomLeft) {
+    addTriangle(topLeft, topRight, bottomLeft);
+    addTriangle(topRight, bottomRight, bottomLeft);
+}
+
+void Geometry::addShape(const ::sf::Shape& shape) {
+    if (shape.getTexture() != nullptr) {
+        addDrawable(shape, shape.getGlobalBounds());
+        return;
+    }
+
+    const size_t count = shape.getPointCount();
+
+    if (count < 3)
+        return;
+
+    const ::sf::Transform& transform = shape.getTransform();
+    const ::sf::FloatRect bounds = shape.getGlobalBounds();
+    const ::sf::Color fill = shape.getFillColor();
+
+    if (fill.a > 0) {
+        beginPrimitive(nullptr, bounds);
+
+        const ::sf::Vertex origin(transform.transformPoint(shape.getPoint(0)),
+                                  fill);
+
+        for (size_t i = 1; i + 1 < count; ++i) {
+            addTriangle(
+                origin,
+                ::sf::Vertex(transform.transformPoint(shape.getPoint(i)),
+                             fill),
+                ::sf::Vertex(transform.transformPoint(shape.getPoint(i + 1)),
+                             fill));
+        }
+    }
+
+    const float thickness = shape.getOutlineThickness();
+    const ::sf::Color outline = shape.getOutlineColor();
+
+    if (thickness == 0 || outline.a == 0)
+        return;
+
+    // Same construction as the outline of ::sf::Shape
+    const ::sf::FloatRect local = shape.getLocalBounds();
+    const ::sf::Vector2f center(local.left + local.width / 2,
+                                local.top + local.height / 2);
+
+    ::std::vector<::sf::Vertex> ring(count * 2);
+
+    for (size_t i = 0; i < count; ++i) {
+        const ::sf::Vector2f previous = shape.getPoint(i == 0 ? count - 1
+                                                              : i - 1);
+        const ::sf::Vector2f current = shape.getPoint(i);
+        const ::sf::Vector2f next = shape.getPoint((i + 1) % count);
+
+        ::sf::Vector2f first = computeNormal(previous, current);
+        ::sf::Vector2f second = computeNormal(current, next);
+
+        // The normals must point towards the outside of the shape
+        const ::sf::Vector2f inside(center.x - current.x,
+                                    center.y - current.y);
+
+        if (first.x * inside.x + first.y * inside.y > 0)
+            first = ::sf::Vector2f(-first.x, -first.y);
+
+        if (second.x * inside.x + second.y * inside.y > 0)
+            second = ::sf::Vector2f(-second.x, -second.y);
+
+        const float factor = 1 + (first.x * second.x + first.y * second.y);
+        const ::sf::Vector2f offset((first.x + second.x) / factor * thickness,
+                                    (first.y + second.y) / factor * thickness);
+
+        ring[i * 2] = ::sf::Vertex(transform.transformPoint(current), outline);
+        ring[i * 2 + 1] = ::sf::Vertex(
+            transform.transformPoint(::sf::Vector2f(current.x + offset.x,
+                                                    current.y + offset.y)),
+            outline);
+    }
+
+    beginPrimitive(nullptr, bounds);
+
+    for (size_t i = 0; i < count; ++i) {
+        const size_t j = (i + 1) % count;
+
+        addQuad(ring[i * 2], ring[i * 2 + 1], ring[j * 2 + 1], ring[j * 2]);
+    }
+}
+
+void Geometry::addSprite(const ::sf::Sprite& sprite) {
+    const ::sf::Texture* texture = sprite.getTexture();
+
+    if (texture == nullptr)
+        return;
+
+    const ::sf::Transform& transform = sprite.getTransform();
+    const ::sf::IntRect& rect = sprite.getTextureRect();
+    const ::sf::Color color = sprite.getColor();
+
+    const float width = static_cast<float>(::std::abs(rect.width));
+    const float height = static_cast<float>(::std::abs(rect.height));
+
+    const float left = static_cast<float>(rect.left);
+    const float top = static_cast<float>(rect.top);
+    const float right = left + static_cast<float>(rect.width);
+    const float bottom = top + static_cast<float>(rect.height);
+
+    beginPrimitive(texture, sprite.getGlobalBounds());
+
+    addQuad(
+        ::sf::Vertex(transform.transformPoint(::sf::Vector2f(0, 0)),
+                     color, ::sf::Vector2f(left, top)),
+        ::sf::Vertex(transform.transformPoint(::sf::Vector2f(width, 0)),
+                     color, ::sf::Vector2f(right, top)),
+        ::sf::Vertex(transform.transformPoint(::sf::Vector2f(width, height)),
+                     color, ::sf::Vector2f(right, bottom)),
+        ::sf::Vertex(transform.transformPoint(::sf::Vector2f(0, height)),
+                     color, ::sf::Vector2f(left, bottom)));
+}
+
+void Geometry::addGlyph(const ::sf::Transform& transform,
+                        const ::sf::Vector2f& position,
+                        const ::sf::Color& color,
+                        const ::sf::Glyph& glyph,
+                        const float& shear,
+                        const float& outline) {
+    const float padding = 1;
+
+    const float left = glyph.bounds.left - padding;
+    const float top = glyph.bounds.top - padding;
+    const float right = glyph.bounds.left + glyph.bounds.width + padding;
+    const float bottom = glyph.bounds.top + glyph.bounds.height + padding;
+
+    const float u1 = static_cast<float>(glyph.textureRect.left) - padding;
+    const float v1 = static_cast<float>(glyph.textureRect.top) - padding;
+    const float u2 = static_cast<float>(glyph.textureRect.left +
+                                        glyph.textureRect.width) + padding;
+    const float v2 = static_cast<float>(glyph.textureRect.top +
+                                        glyph.textureRect.height) + padding;
+
+    const float x = position.x - outline;
+    const float y = position.y - outline;
+
+    addQuad(
+        ::sf::Vertex(transform.transformPoint(x + left - shear * top,
+                                              y + top),
+                     color, ::sf::Vector2f(u1, v1)),
+        ::sf::Vertex(transform.transformPoint(x + right - shear * top,
+                                              y + top),
+                     color, ::sf::Vector2f(u2, v1)),
+        ::sf::Vertex(transform.transformPoint(x + right - shear * bottom,
+                                              y + bottom),
+                     color, ::sf::Vector2f(u2, v2)),
+        ::sf::Vertex(transform.transformPoint(x + left - shear * bottom,
+                                              y + bottom),
+                     color, ::sf::Vector2f(u1, v2)));
+}
+
+void Geometry::addLine(const ::sf::Transform& transform,
+                       const float& length,
+                       const float& baseline,
+                       const ::sf::Color& color,
+                       const float& offset,
+                       const float& thickness,
+                       const float& outline) {
+    const float top = ::std::floor(baseline + offset - thickness / 2 + 0.5f);
+    const float bottom = top + ::std::floor(thickness + 0.5f);
+
+    // The font texture has a white pixel at (1, 1)
+    const ::sf::Vector2f white(1, 1);
+
+    addQuad(
+        ::sf::Vertex(transform.transformPoint(-outline, top - outline),
+                     color, white),
+        ::sf::Vertex(transform.transformPoint(length + outline,
+                                              top - outline),
+                     color, white),
+        ::sf::Vertex(transform.transformPoint(length + outline,
+                                              bottom + outline),
+                     color, white),
+        ::sf::Vertex(transform.transformPoint(-outline, bottom + outline),
+                     color, white));
+}
+
+void Geometry::addText(const ::sf::Text& text) {
+    const ::sf::Font* font = text.getFont();
+    const ::sf::String& string = text.getString();
+
+    if (font == nullptr || string.isEmpty())
+        return;
+
+    const unsigned int size = text.getCharacterSize();
+    const ::sf::Uint32 style = text.getStyle();
+    const ::sf::Transform& transform = text.getTransform();
+
+    const bool bold = (style & ::sf::Text::Bold) != 0;
+    const bool underlined = (style & ::sf::Text::Underlined) != 0;
+    const bool strikeThrough = (style & ::sf::Text::StrikeThrough) != 0;
+
+    // Same layout as ::sf::Text, including the 12 degrees italic shear
+    const float shear = (style & ::sf::Text::Italic) ? 0.209f : 0;
+
+    const float underlineOffset = font->getUnderlinePosition(size);
+    const float underlineThickness = font->getUnderlineThickness(size);
+
+    const ::sf::FloatRect xBounds = font->getGlyph(L'x', size, bold).bounds;
+    const float strikeThroughOffset = xBounds.top + xBounds.height / 2;
+
+    float whitespace = font->getGlyph(L' ', size, bold).advance;
+    const float letterSpacing =
+        (whitespace / 3) * (text.getLetterSpacing() - 1);
+
+    whitespace += letterSpacing;
+
+    const float lineSpacing =
+        font->getLineSpacing(size) * text.getLineSpacing();
+
+    const float thickness = text.getOutlineThickness();
+    const bool outlined = thickness != 0 && text.getOutlineColor().a > 0;
+
+    beginPrimitive(&font->getTexture(size), text.getGlobalBounds());
+
+    // The outline of all glyphs is drawn below their fill
+    for (int pass = outlined ? 0 : 1; pass < 2; ++pass) {
+        const bool fill = pass == 1;
+        const float outline = fill ? 0 : thickness;
+        const ::sf::Color color = fill ? text.getFillColor()
+                                       : text.getOutlineColor();
+
+        float x = 0;
+        float y = static_cast<float>(size);
+        ::sf::Uint32 previous = 0;
+
+        for (size_t i = 0; i < string.getSize(); ++i) {
+            const ::sf::Uint32 current = string[i];
+
+            if (current == L'\r')
+                continue;
+
+            x += font->getKerning(previous, current, size);
+
+            if (current == L'\n' && previous != L'\n') {
+                if (underlined)
+                    addLine(transform, x, y, color, underlineOffset,
+                            underlineThickness, outline);
+
+                if (strikeThrough)
+                    addLine(transform, x, y, color, strikeThroughOffset,
+                            underlineThickness, outline);
+            }
+
+            previous = current;
+
+            switch (current) {
+                case L' ':
+                    x += whitespace;
+                    continue;
+                case L'\t':
+                    x += whitespace * 4;
+                    continue;
+                case L'\n':
+                    y += lineSpacing;
+                    x = 0;
+                    continue;
+                default:
+                    break;
+            }
+
+            const ::sf::Glyph& glyph = font->getGlyph(current, size, bold,
+                                                      outline);
+
+            addGlyph(transform, ::sf::Vector2f(x, y), color, glyph, shear,
+                     outline);
+
+            x += glyph.advance + letterSpacing;
+        }
+
+        if (x > 0) {
+            if (underlined)
+                addLine(transform, x, y, color, underlineOffset,
+                        underlineThickness, outline);
+
+            if (strikeThrough)
+                addLine(transform, x, y, color, strikeThroughOffset,
+                        underlineThickness, outline);
+        }
+    }
+}
+
+void Geometry::addDrawable(const ::sf::Drawable& drawable,
+                           const ::sf::FloatRect& bounds) {
+    Primitive primitive;
+
+    primitive.drawable = &drawable;
+    primitive.first = static_cast<uint32_t>(_vertices.size());
+    primitive.bounds = bounds;
+
+    _primitives.push_back(primitive);
+}
+
+const ::std::vector<::sf::Vertex>& Geometry::getVertices() const {
+    return _vertices;
+}
+
+const ::std::vector<Geometry::Primitive>& Geometry::getPrimitives() const {
+    return _primitives;
+}
+
+}  // namespace easyGUI
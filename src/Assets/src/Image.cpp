@@ -73,16 +73,21 @@ Image::Image(const Point& startLocation,
           Point(startLocation.Xcoord + width, startLocation.Ycoord + height),
           path) {}
 
-bool Image::isMouseHover() const {
-    if (_container != nullptr) {
-        ::sf::Vector2i currentPosition = ::sf::Mouse::getPosition(*_container);
-        ::sf::Vector2f worldPos = _container->mapPixelToCoords(currentPosition);
+bool Image::buildGeometry(Geometry& geometry) const {
+    // Subclasses may override draw
+    if (!isExactly<Image>())
+        return false;
 
-        if (_object.getGlobalBounds().contains(worldPos.x, worldPos.y))
-            return true;
-    }
+    geometry.addSprite(_object);
+
+    if (_border)
+        geometry.addShape(*_border);
 
-    return false;
+    return true;
+}
+
+::sf::FloatRect Image::getBounds() const {
+    return _object.getGlobalBounds();
 }
 
 void Image::constructFrame(const uint32_t thickness) {
@@ -105,43 +110,47 @@ void Image::toggleFrame(const uint32_t thickness) {
         _border.reset();
     else
         constructFrame(thickness);
+
+    markDirty();
 }
 
 void Image::updateLocation(const Point& newLocation) {
     _object.setPosition(newLocation.Xcoord, newLocation.Ycoord);
+    markDirty();
 
     AlignmentTool& tool = AlignmentTool::getInstance();
     tool.triggerUpdate(this);
 }
 
 Point Image::getLEFT() const {
-    return Point(
-        _object.getGlobalBounds().left,
-        _object.getGlobalBounds().top + _object.getGlobalBounds().height / 2);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left, bounds.top + bounds.height / 2);
 }
 
 Point Image::getRIGHT() const {
-    return Point(
-        _object.getGlobalBounds().left + _object.getGlobalBounds().width,
-        _object.getGlobalBounds().top + _object.getGlobalBounds().height / 2);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left + bounds.width, bounds.top + bounds.height / 2);
 }
 
 Point Image::getTOP() const {
-    return Point(
-        _object.getGlobalBounds().left + _object.getGlobalBounds().width / 2,
-        _object.getGlobalBounds().top);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left + bounds.width / 2, bounds.top);
 }
 
 Point Image::getBOTTOM() const {
-    return Point(
-        _object.getGlobalBounds().left + _object.getGlobalBounds().width / 2,
-        _object.getGlobalBounds().top + _object.getGlobalBounds().height);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left + bounds.width / 2, bounds.top + bounds.height);
 }
 
 Point Image::getCENTER() const {
-    return Point(
-        _object.getGlobalBounds().left + _object.getGlobalBounds().width / 2,
-        _object.getGlobalBounds().top + _object.getGlobalBounds().height / 2);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left + bounds.width / 2,
+                 bounds.top + bounds.height / 2);
 }
 
 }  // namespace easyGUI
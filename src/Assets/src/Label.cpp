@@ -36,20 +36,23 @@ void Label::draw(::sf::RenderTarget& target,
     target.draw(_text, states);
 }
 
-bool Label::isMouseHover() const {
-    if (_container != nullptr) {
-        ::sf::Vector2i currentPosition = ::sf::Mouse::getPosition(*_container);
-        ::sf::Vector2f worldPos = _container->mapPixelToCoords(currentPosition);
+bool Label::buildGeometry(Geometry& geometry) const {
+    // Subclasses may override draw
+    if (!isExactly<Label>())
+        return false;
 
-        if (_text.getGlobalBounds().contains(worldPos.x, worldPos.y))
-            return true;
-    }
+    geometry.addText(_text);
+
+    return true;
+}
 
-    return false;
+::sf::FloatRect Label::getBounds() const {
+    return _text.getGlobalBounds();
 }
 
 void Label::updateLocation(const Point& newLocation) {
     _text.setPosition(newLocation.Xcoord, newLocation.Ycoord);
+    markDirty();
 }
 
 void Label::toggleDecoration(const TextDecoration& deco) {
@@ -60,6 +63,8 @@ void Label::toggleDecoration(const TextDecoration& deco) {
             return elem == deco;
     });
 
+    markDirty();
+
     if (removed)
         return;
 
@@ -125,33 +130,36 @@ Label::Label(const Point& startLocation,
 }
 
 Point Label::getLEFT() const {
-    return Point(
-        _text.getGlobalBounds().left - 1,
-        _text.getGlobalBounds().top - 7 + _text.getGlobalBounds().height / 2);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left - 1, bounds.top - 7 + bounds.height / 2);
 }
 
 Point Label::getRIGHT() const {
-    return Point(
-        _text.getGlobalBounds().left - 1 + _text.getGlobalBounds().width,
-        _text.getGlobalBounds().top - 7 + _text.getGlobalBounds().height / 2);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left - 1 + bounds.width,
+                 bounds.top - 7 + bounds.height / 2);
 }
 
 Point Label::getTOP() const {
-    return Point(
-        _text.getGlobalBounds().left - 1 + _text.getGlobalBounds().width / 2,
-        _text.getGlobalBounds().top - 7);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left - 1 + bounds.width / 2, bounds.top - 7);
 }
 
 Point Label::getBOTTOM() const {
-    return Point(
-        _text.getGlobalBounds().left - 1 + _text.getGlobalBounds().width / 2,
-        _text.getGlobalBounds().top - 7+ _text.getGlobalBounds().height);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left - 1 + bounds.width / 2,
+                 bounds.top - 7 + bounds.height);
 }
 
 Point Label::getCENTER() const {
-    return Point(
-        _text.getGlobalBounds().left - 1 + _text.getGlobalBounds().width / 2,
-        _text.getGlobalBounds().top - 7 + _text.getGlobalBounds().height / 2);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left - 1 + bounds.width / 2,
+                 bounds.top - 7 + bounds.height / 2);
 }
 
 }  // namespace easyGUI
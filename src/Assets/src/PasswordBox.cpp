@@ -35,14 +35,14 @@ PasswordBox::PasswordBox(const Point& startLocation,
                          const Point& endLocation,
                          const ::std::string& fontPath,
                          const uint32_t charSize) :
-    TextBox(startLocation, endLocation, fontPath, charSize) {}
+    TaggedComponent(startLocation, endLocation, fontPath, charSize) {}
 
 PasswordBox::PasswordBox(const Point& startLocation,
                          const float& width,
                          const float& height,
                          const ::std::string& fontPath,
                          const uint32_t charSize) :
-    TextBox(startLocation, width, height, fontPath, charSize) {}
+    TaggedComponent(startLocation, width, height, fontPath, charSize) {}
 
 ::std::string PasswordBox::getText() const {
     return _passText;
@@ -66,6 +66,7 @@ void PasswordBox::updateText(const uint32_t text) {
 
     _text->getInternalText().setString(newContent);
     applyCharSizeCorrection();
+    markDirty();
     tool.triggerUpdate(this);
 
     if (_text->getInternalText().getCharacterSize() < desiredSize)
@@ -53,16 +53,18 @@ void Separator::draw(::sf::RenderTarget& target,
     target.draw(_shape, states);
 }
 
-bool Separator::isMouseHover() const {
-    if (_container != nullptr) {
-        ::sf::Vector2i currentPosition = ::sf::Mouse::getPosition(*_container);
-        ::sf::Vector2f worldPos = _container->mapPixelToCoords(currentPosition);
+bool Separator::buildGeometry(Geometry& geometry) const {
+    // Subclasses may override draw
+    if (!isExactly<Separator>())
+        return false;
 
-        if (_shape.getGlobalBounds().contains(worldPos.x, worldPos.y))
-            return true;
-    }
+    geometry.addShape(_shape);
 
-    return false;
+    return true;
+}
+
+::sf::FloatRect Separator::getBounds() const {
+    return _shape.getGlobalBounds();
 }
 
 ::sf::RectangleShape& Separator::getInternalSeparator() {
@@ -71,39 +73,41 @@ bool Separator::isMouseHover() const {
 
 void Separator::updateLocation(const Point& newLocation) {
     _shape.setPosition(newLocation.Xcoord, newLocation.Ycoord);
+    markDirty();
 
     AlignmentTool& tool = AlignmentTool::getInstance();
     tool.triggerUpdate(this);
 }
 
 Point Separator::getLEFT() const {
-    return Point(
-        _shape.getGlobalBounds().left,
-        _shape.getGlobalBounds().top + _shape.getGlobalBounds().height / 2);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left, bounds.top + bounds.height / 2);
 }
 
 Point Separator::getRIGHT() const {
-    return Point(
-        _shape.getGlobalBounds().left + _shape.getGlobalBounds().width,
-        _shape.getGlobalBounds().top + _shape.getGlobalBounds().height / 2);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left + bounds.width, bounds.top + bounds.height / 2);
 }
 
 Point Separator::getTOP() const {
-    return Point(
-        _shape.getGlobalBounds().left + _shape.getGlobalBounds().width / 2,
-        _shape.getGlobalBounds().top);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left + bounds.width / 2, bounds.top);
 }
 
 Point Separator::getBOTTOM() const {
-    return Point(
-        _shape.getGlobalBounds().left + _shape.getGlobalBounds().width / 2,
-        _shape.getGlobalBounds().top + _shape.getGlobalBounds().height);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left + bounds.width / 2, bounds.top + bounds.height);
 }
 
 Point Separator::getCENTER() const {
-    return Point(
-        _shape.getGlobalBounds().left + _shape.getGlobalBounds().width / 2,
-        _shape.getGlobalBounds().top + _shape.getGlobalBounds().height / 2);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left + bounds.width / 2,
+                 bounds.top + bounds.height / 2);
 }
 
 }  // namespace easyGUI
@@ -0,0 +1,61 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file Task.cpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Implementation of the TaskScheduler class
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#include <atomic>
+
+#include <Task.hpp>
+
+namespace easyGUI {
+
+// The scheduler may be replaced while worker threads are running tasks
+static ::std::atomic<TaskScheduler*> installedScheduler(nullptr);
+
+void TaskScheduler::setInstance(TaskScheduler* scheduler) {
+    installedScheduler.store(scheduler);
+}
+
+TaskScheduler* TaskScheduler::getInstance() {
+    return installedScheduler.load();
+}
+
+void TaskScheduler::run(const ::std::shared_ptr<Task>& task) {
+    if (task == nullptr)
+        return;
+
+    TaskScheduler* scheduler = getInstance();
+
+    if (task->isAsync() && scheduler != nullptr) {
+        scheduler->schedule(task);
+        return;
+    }
+
+    task->exec();
+}
+
+}  // namespace easyGUI
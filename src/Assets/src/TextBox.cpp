@@ -28,6 +28,7 @@
  * @copyright Copyright (c) 2022
  */
 
+#include <PasswordBox.hpp>
 #include <Textbox.hpp>
 
 namespace easyGUI {
@@ -54,6 +55,11 @@ void TextBox::applyCharSizeCorrection() {
         freeSpaceX = _shape.getGlobalBounds().width - lenghtInPix;
         freeSpaceY = _shape.getGlobalBounds().height - heightInPix;
     }
+
+    // The label was changed through its internal text. The owner draws
+    // the label as part of its own geometry, so it changed as well.
+    _text->markDirty();
+    markDirty();
 }
 
 TextBox* TextBox::getSelectedBox() {
@@ -66,6 +72,7 @@ bool& TextBox::getTextBoxClicked() {
 
 void TextBox::updateLocation(const Point& newLocation) {
     _shape.setPosition(newLocation.Xcoord, newLocation.Ycoord);
+    markDirty();
 
     AlignmentTool& tool = AlignmentTool::getInstance();
     tool.triggerUpdate(this);
@@ -92,6 +99,9 @@ TextBox::TextBox(const Point& startLocation,
         _text = ::std::make_shared<Label>(Point(), "", fontPath, charSize);
         Anchor* cast = static_cast<Anchor*>(_text.get());
 
+        // The label lives as long as the box, whichever menu it is in
+        AlignmentTool::ScopeGuard guard(GLOBAL_SCOPE);
+
         tool.createBinding(
             cast,
             this,
@@ -125,16 +135,21 @@ void TextBox::draw(::sf::RenderTarget& target,
         target.draw(*_text, states);
 }
 
-bool TextBox::isMouseHover() const {
-    if (_container != nullptr) {
-        ::sf::Vector2i currentPosition = ::sf::Mouse::getPosition(*_container);
-        ::sf::Vector2f worldPos = _container->mapPixelToCoords(currentPosition);
+bool TextBox::buildGeometry(Geometry& geometry) const {
+    // Subclasses may override draw
+    if (!isExactly<TextBox>() && !isExactly<PasswordBox>())
+        return false;
 
-        if (_shape.getGlobalBounds().contains(worldPos.x, worldPos.y))
-            return true;
-    }
+    geometry.addShape(_shape);
+
+    if (!_text->getInternalText().getString().isEmpty())
+        return _text->buildGeometry(geometry);
+
+    return true;
+}
 
-    return false;
+::sf::FloatRect TextBox::getBounds() const {
+    return _shape.getGlobalBounds();
 }
 
 TextBox::~TextBox() {
@@ -163,6 +178,7 @@ void TextBox::updateText(const uint32_t text) {
 
     _text->getInternalText().setString(newContent);
     applyCharSizeCorrection();
+    markDirty();
 
     if (_text->getInternalText().getCharacterSize() < desiredSize)
         WARN << "[TextBox] Text has been resized in order to fit.\n";
@@ -170,14 +186,14 @@ void TextBox::updateText(const uint32_t text) {
     tool.triggerUpdate(this);
 }
 
-void TextBox::onClick() {
-    if (isMouseHover()) {
+void TextBox::onClick(const Point& point) {
+    if (isMouseHover(point)) {
         selectedBox = this;
         textBoxClicked = true;
     }
 
     if (_onClick != nullptr) {
-        _onClick->exec();
+        TaskScheduler::run(_onClick);
     }
 }
 
@@ -187,36 +203,39 @@ void TextBox::onClick() {
 
 void TextBox::clear() {
     _text->getInternalText().setString("");
+    _text->markDirty();
+    markDirty();
 }
 
 Point TextBox::getLEFT() const {
-    return Point(
-        _shape.getGlobalBounds().left,
-        _shape.getGlobalBounds().top + _shape.getGlobalBounds().height / 2);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left, bounds.top + bounds.height / 2);
 }
 
 Point TextBox::getRIGHT() const {
-    return Point(
-        _shape.getGlobalBounds().left + _shape.getGlobalBounds().width,
-        _shape.getGlobalBounds().top + _shape.getGlobalBounds().height / 2);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left + bounds.width, bounds.top + bounds.height / 2);
 }
 
 Point TextBox::getTOP() const {
-    return Point(
-        _shape.getGlobalBounds().left + _shape.getGlobalBounds().width / 2,
-        _shape.getGlobalBounds().top);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left + bounds.width / 2, bounds.top);
 }
 
 Point TextBox::getBOTTOM() const {
-    return Point(
-        _shape.getGlobalBounds().left + _shape.getGlobalBounds().width / 2,
-        _shape.getGlobalBounds().top + _shape.getGlobalBounds().height);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left + bounds.width / 2, bounds.top + bounds.height);
 }
 
 Point TextBox::getCENTER() const {
-    return Point(
-        _shape.getGlobalBounds().left + _shape.getGlobalBounds().width / 2,
-        _shape.getGlobalBounds().top + _shape.getGlobalBounds().height / 2);
+    const ::sf::FloatRect& bounds = getCachedBounds();
+
+    return Point(bounds.left + bounds.width / 2,
+                 bounds.top + bounds.height / 2);
 }
 
 }  // namespace easyGUI
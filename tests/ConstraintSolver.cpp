@@ -0,0 +1,518 @@
+// Copyright © 2022 David Bogdan
+
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files
+// (the “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the following
+// conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file ConstraintSolver.cpp
+ * @author David Bogdan (david.bnicolae@gmail.com)
+ * @brief Checks of the ConstraintSolver and ConstraintLayout classes
+ * 
+ * @details Covers constraints of every strength, edit variables, the removal
+ * of constraints and the rejection of unsatisfiable ones, then the layout
+ * moving components when the window is resized and releasing the variables
+ * of removed anchors. Returns a non-zero status if any check fails.
+ * 
+ * @copyright Copyright (c) 2022
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include <ConstraintLayout.hpp>
+#include <ConstraintSolver.hpp>
+
+using easyGUI::ConstraintLayout;
+using easyGUI::ConstraintSolver;
+using easyGUI::ConstraintId;
+using easyGUI::Expression;
+using easyGUI::Variable;
+using easyGUI::BindingPoint;
+using easyGUI::Component;
+using easyGUI::Anchor;
+using easyGUI::Point;
+
+using easyGUI::INVALID_CONSTRAINT;
+using easyGUI::STRENGTH_REQUIRED;
+using easyGUI::STRENGTH_STRONG;
+using easyGUI::STRENGTH_MEDIUM;
+using easyGUI::STRENGTH_WEAK;
+using easyGUI::LESS_EQUAL;
+using easyGUI::EQUAL;
+using easyGUI::GREATER_EQUAL;
+using easyGUI::LayoutAttribute;
+using easyGUI::ATTRIBUTE_LEFT;
+using easyGUI::ATTRIBUTE_RIGHT;
+using easyGUI::ATTRIBUTE_TOP;
+using easyGUI::ATTRIBUTE_BOTTOM;
+using easyGUI::ATTRIBUTE_WIDTH;
+using easyGUI::ATTRIBUTE_HEIGHT;
+
+static uint32_t failures = 0;
+
+static void check(const bool condition, const char* description) {
+    if (condition)
+        return;
+
+    ::std::cerr << "FAILED: " << description << "\n";
+    failures++;
+}
+
+static bool near(const double& value, const double& expected) {
+    return ::std::abs(value - expected) < 1.0e-6;
+}
+
+// A component of fixed size, moved only by the layout
+class Box : public Component, public Anchor {
+ public:
+    Box(const float& left, const float& top) : _left(left), _top(top) {}
+
+    void updateLocation(const Point& location) override {
+        _left = location.Xcoord;
+        _top = location.Ycoord;
+        markDirty();
+    }
+
+    ::sf::FloatRect getBounds() const override {
+        return ::sf::FloatRect(_left, _top, WIDTH, HEIGHT);
+    }
+
+    Point getLEFT() const override {
+        return Point(_left, _top + HEIGHT / 2);
+    }
+
+    Point getRIGHT() const override {
+        return Point(_left + WIDTH, _top + HEIGHT / 2);
+    }
+
+    Point getTOP() const override {
+        return Point(_left + WIDTH / 2, _top);
+    }
+
+    Point getBOTTOM() const override {
+        return Point(_left + WIDTH / 2, _top + HEIGHT);
+    }
+
+    Point getCENTER() const override {
+        return Point(_left + WIDTH / 2, _top + HEIGHT / 2);
+    }
+
+    Component* toComponent() override {
+        return this;
+    }
+
+    void draw(::sf::RenderTarget&, ::sf::RenderStates) const override {}
+
+    float getLeft() const {
+        return _left;
+    }
+
+    float getTop() const {
+        return _top;
+    }
+
+    static constexpr float WIDTH = 40.0f;
+    static constexpr float HEIGHT = 20.0f;
+
+ private:
+    float _left;
+    float _top;
+};
+
+static void checkRequired() {
+    ConstraintSolver solver;
+    Variable x = solver.createVariable();
+    Variable y = solver.createVariable();
+
+    // x + y = 10, x = 3
+    solver.addConstraint(Expression(x).add(y).add(-10.0), EQUAL);
+    solver.addConstraint(Expression(x) - 3.0, EQUAL);
+
+    check(near(solver.getValue(x), 3.0), "required equality holds");
+    check(near(solver.getValue(y), 7.0), "required equalities combine");
+
+    // y is required to be 7, so it cannot be at most 5
+    const ConstraintId conflict =
+        solver.addConstraint(Expression(y) - 5.0, LESS_EQUAL);
+
+    check(conflict == INVALID_CONSTRAINT, "required conflict is rejected");
+    check(solver.getConstraintCount() == 2, "rejected constraint is dropped");
+    check(near(solver.getValue(x), 3.0) && near(solver.getValue(y), 7.0),
+          "rejected constraint leaves the solution as it was");
+
+    const ConstraintId equal =
+        solver.addConstraint(Expression(x) - 4.0, EQUAL);
+
+    check(equal == INVALID_CONSTRAINT, "conflicting equality is rejected");
+    check(near(solver.getValue(x), 3.0), "conflicting equality is rolled back");
+}
+
+static void checkInfeasibleInequality() {
+    ConstraintSolver solver;
+    Variable x = solver.createVariable();
+
+    const ConstraintId lower =
+        solver.addConstraint(Expression(x) - 10.0, GREATER_EQUAL);
+
+    check(lower != INVALID_CONSTRAINT, "inequality is added");
+    check(solver.getValue(x) >= 10.0 - 1.0e-6, "inequality holds");
+
+    // Only satisfiable through an artificial variable, which fails
+    const ConstraintId upper =
+        solver.addConstraint(Expression(x) - 5.0, LESS_EQUAL);
+
+    check(upper == INVALID_CONSTRAINT, "unsatisfiable inequality is rejected");
+    check(solver.getValue(x) >= 10.0 - 1.0e-6,
+          "unsatisfiable inequality is rolled back");
+
+    const ConstraintId bounded =
+        solver.addConstraint(Expression(x) - 20.0, LESS_EQUAL);
+
+    check(bounded != INVALID_CONSTRAINT, "solver accepts constraints again");
+    check(solver.getValue(x) >= 10.0 - 1.0e-6 &&
+          solver.getValue(x) <= 20.0 + 1.0e-6,
+          "both bounds hold");
+}
+
+static void checkStrengths() {
+    ConstraintSolver solver;
+    Variable x = solver.createVariable();
+
+    const ConstraintId weak =
+        solver.addConstraint(Expression(x) - 10.0, EQUAL, STRENGTH_WEAK);
+    const ConstraintId strong =
+        solver.addConstraint(Expression(x) - 20.0, EQUAL, STRENGTH_STRONG);
+
+    check(near(solver.getValue(x), 20.0), "strong wins over weak");
+
+    // Many weak constraints still lose against a single strong one
+    ::std::vector<ConstraintId> crowd;
+
+    for (int i = 0; i < 50; ++i)
+        crowd.push_back(
+            solver.addConstraint(Expression(x) - 30.0, EQUAL, STRENGTH_WEAK));
+
+    check(near(solver.getValue(x), 20.0), "strong wins over many weak ones");
+
+    solver.removeConstraint(strong);
+
+    check(near(solver.getValue(x), 30.0), "majority of weak ones wins");
+
+    for (const ConstraintId& constraint : crowd)
+        solver.removeConstraint(constraint);
+
+    check(near(solver.getValue(x), 10.0), "remaining weak constraint wins");
+
+    // A required bound limits the weak preference
+    solver.addConstraint(Expression(x) - 15.0, GREATER_EQUAL);
+
+    check(near(solver.getValue(x), 15.0), "required wins over weak");
+
+    solver.removeConstraint(weak);
+    solver.addConstraint(Expression(x) - 18.0, EQUAL, STRENGTH_MEDIUM);
+
+    check(near(solver.getValue(x), 18.0), "medium is kept within bounds");
+}
+
+static void checkEdits() {
+    ConstraintSolver solver;
+    Variable x = solver.createVariable();
+    Variable y = solver.createVariable();
+    Variable z = solver.createVariable();
+
+    check(!solver.addEditVariable(x, STRENGTH_REQUIRED),
+          "required edit variables are refused");
+    check(solver.addEditVariable(x, STRENGTH_STRONG), "edit variable is added");
+    check(!solver.addEditVariable(x, STRENGTH_STRONG),
+          "edit variable is only added once");
+
+    solver.addConstraint(Expression(y) - Expression(x) - 10.0, EQUAL);
+    solver.addConstraint(Expression(z) - 100.0, EQUAL);
+
+    ::std::vector<Variable> changed;
+
+    solver.takeChangedVariables(changed);
+    changed.clear();
+
+    const double suggestions[] = {5.0, 30.0, -12.5, 5.0};
+
+    for (const double& value : suggestions) {
+        check(solver.suggestValue(x, value), "value is suggested");
+        check(near(solver.getValue(x), value), "edit variable follows");
+        check(near(solver.getValue(y), value + 10.0),
+              "dependent variable follows");
+    }
+
+    solver.takeChangedVariables(changed);
+
+    auto has = [&changed](const Variable& variable) {
+        return ::std::any_of(changed.begin(), changed.end(),
+            [&variable](const Variable& other) {
+                return other.id == variable.id;
+        });
+    };
+
+    check(has(y), "changed variables are reported");
+    check(!has(z), "unrelated variables are not reported");
+
+    // Required constraints win over suggestions
+    solver.addConstraint(Expression(y) - 50.0, LESS_EQUAL);
+    solver.suggestValue(x, 100.0);
+
+    check(near(solver.getValue(y), 50.0), "suggestion is bounded");
+
+    check(solver.removeEditVariable(x), "edit variable is removed");
+    check(!solver.hasEditVariable(x), "edit variable is gone");
+    check(!solver.suggestValue(x, 1.0), "suggestions need an edit variable");
+}
+
+static void checkRemoval() {
+    ConstraintSolver solver;
+    Variable x = solver.createVariable();
+    Variable y = solver.createVariable();
+
+    solver.addEditVariable(x, STRENGTH_STRONG);
+    solver.suggestValue(x, 10.0);
+
+    // Required equalities are marked by dummy symbols
+    const ConstraintId link =
+        solver.addConstraint(Expression(y) - Expression(x), EQUAL);
+
+    check(near(solver.getValue(y), 10.0), "linked variable follows");
+    check(solver.removeConstraint(link), "dummy marked constraint is removed");
+    check(!solver.hasConstraint(link), "removed constraint is gone");
+    check(!solver.removeConstraint(link), "constraints are removed once");
+
+    solver.suggestValue(x, 20.0);
+
+    check(!near(solver.getValue(y), 20.0), "removed link no longer applies");
+
+    // The marker of a fixed variable leaves through the variable's row
+    const ConstraintId fixed =
+        solver.addConstraint(Expression(y) - 5.0, EQUAL);
+
+    solver.removeConstraint(fixed);
+
+    check(solver.addConstraint(Expression(y) - 7.0, EQUAL) !=
+          INVALID_CONSTRAINT, "variable is free after its removal");
+    check(near(solver.getValue(y), 7.0), "new value of the variable holds");
+
+    // Removing soft constraints also drops their other error symbol, so the
+    // objective stays bounded
+    Variable z = solver.createVariable();
+    ::std::vector<ConstraintId> soft;
+
+    for (int i = 0; i < 10; ++i) {
+        soft.push_back(solver.addConstraint(
+            Expression(z) - static_cast<double>(i), GREATER_EQUAL,
+            STRENGTH_MEDIUM));
+        soft.push_back(solver.addConstraint(
+            Expression(z) - static_cast<double>(i), EQUAL, STRENGTH_WEAK));
+    }
+
+    for (const ConstraintId& constraint : soft)
+        check(solver.removeConstraint(constraint), "soft one is removed");
+
+    // The symbols of removed constraints are reused by the next ones
+    for (int i = 0; i < 100; ++i) {
+        const ConstraintId constraint = solver.addConstraint(
+            Expression(z) - static_cast<double>(i), EQUAL, STRENGTH_MEDIUM);
+
+        check(near(solver.getValue(z), static_cast<double>(i)),
+              "recycled symbols are sound");
+        solver.removeConstraint(constraint);
+    }
+
+    solver.addConstraint(Expression(z) - 42.0, EQUAL, STRENGTH_STRONG);
+
+    check(near(solver.getValue(z), 42.0), "solver is sound after removals");
+    check(solver.getConstraintCount() == 3,
+          "only the live constraints are counted");
+}
+
+static void checkRelease() {
+    ConstraintSolver solver;
+    Variable x = solver.createVariable();
+    Variable y = solver.createVariable();
+
+    const ConstraintId constraint =
+        solver.addConstraint(Expression(x) - Expression(y) - 3.0, EQUAL);
+
+    check(!solver.releaseVariable(x), "used variables are not released");
+
+    solver.removeConstraint(constraint);
+
+    check(solver.releaseVariable(x), "unused variable is released");
+    check(!solver.releaseVariable(x), "variables are released once");
+    check(solver.addConstraint(Expression(x) - 1.0, EQUAL) ==
+          INVALID_CONSTRAINT, "released variables cannot be constrained");
+
+    Variable reused = solver.createVariable();
+
+    check(reused.id == x.id, "slot of a released variable is reused");
+
+    solver.addConstraint(Expression(reused) - 8.0, EQUAL);
+
+    check(near(solver.getValue(reused), 8.0), "reused variable is solved");
+    check(near(solver.getValue(y), 0.0), "other variables are untouched");
+}
+
+static void checkLayoutResize() {
+    ConstraintLayout& layout = ConstraintLayout::getInstance();
+
+    layout.setWindowArea(::sf::FloatRect(0.0f, 0.0f, 800.0f, 600.0f));
+
+    // a sticks to the right edge of the window and b is aligned with it,
+    // somewhere below it and within the window
+    Box a(10.0f, 10.0f);
+    Box b(500.0f, 300.0f);
+
+    layout.addConstraint(layout.getExpression(&a, ATTRIBUTE_RIGHT) -
+                         layout.getWindowExpression(ATTRIBUTE_RIGHT) + 20.0,
+                         EQUAL);
+    layout.addConstraint(layout.getExpression(&b, ATTRIBUTE_LEFT) -
+                         layout.getExpression(&a, ATTRIBUTE_LEFT), EQUAL);
+    layout.addConstraint(layout.getExpression(&b, ATTRIBUTE_TOP) -
+                         layout.getExpression(&a, ATTRIBUTE_BOTTOM) - 5.0,
+                         GREATER_EQUAL);
+    layout.addConstraint(layout.getExpression(&b, ATTRIBUTE_BOTTOM) -
+                         layout.getWindowExpression(ATTRIBUTE_BOTTOM),
+                         LESS_EQUAL);
+
+    check(layout.update() == 2, "constrained components are moved");
+    check(near(a.getLeft(), 740.0), "component follows the window edge");
+    check(near(b.getLeft(), 740.0), "aligned component follows");
+    check(near(a.getTop(), 10.0) && near(b.getTop(), 300.0),
+          "undecided positions stay as measured");
+    check(layout.update() == 0, "solved layout moves nothing");
+
+    layout.setWindowArea(::sf::FloatRect(0.0f, 0.0f, 400.0f, 300.0f));
+
+    check(layout.update() == 2, "resize moves the constrained components");
+    check(near(a.getLeft(), 340.0) && near(a.getTop(), 10.0),
+          "component follows the resized window");
+    check(near(b.getLeft(), 340.0) && near(b.getTop(), 280.0),
+          "component is kept within the resized window");
+
+    layout.setWindowArea(::sf::FloatRect(0.0f, 0.0f, 800.0f, 600.0f));
+
+    check(layout.update() == 2, "resize back moves the components back");
+    check(near(b.getLeft(), 740.0) && near(b.getTop(), 300.0),
+          "component returns where it was measured");
+
+    // Moved by hand, the anchor pushes the other component down
+    a.updateLocation(Point(a.getLeft(), 400.0f));
+
+    check(layout.update() == 1, "only the pushed component is moved");
+    check(near(a.getTop(), 400.0), "moved component keeps its position");
+    check(near(b.getTop(), 425.0), "pushed component follows");
+}
+
+static void checkLayoutRemoval() {
+    ConstraintLayout& layout = ConstraintLayout::getInstance();
+    const size_t count = layout.getConstraintCount();
+
+    layout.setWindowArea(::sf::FloatRect(0.0f, 0.0f, 800.0f, 600.0f));
+
+    Box* a = new Box(0.0f, 0.0f);
+    Box b(0.0f, 0.0f);
+
+    layout.addConstraint(layout.getExpression(a, ATTRIBUTE_LEFT) - 100.0,
+                         EQUAL);
+    layout.addConstraint(layout.getExpression(a, ATTRIBUTE_TOP) - 100.0,
+                         EQUAL);
+    layout.addBinding(&b, a, BindingPoint::LEFT, BindingPoint::RIGHT,
+                      Point(10.0f, 0.0f));
+    layout.update();
+
+    check(near(b.getLeft(), 150.0) && near(b.getTop(), 100.0),
+          "bound component is placed");
+    check(layout.getConstraintCount() == count + 3, "constraints are counted");
+
+    const LayoutAttribute attributes[] = {ATTRIBUTE_LEFT, ATTRIBUTE_TOP,
+                                          ATTRIBUTE_WIDTH, ATTRIBUTE_HEIGHT};
+    ::std::vector<uint32_t> released;
+
+    for (const LayoutAttribute& attribute : attributes) {
+        const Expression expression = layout.getExpression(a, attribute);
+
+        released.push_back(expression.getTerms().front().variable.id);
+    }
+
+    // Destroying the anchor removes its constraints and releases its
+    // variables, whose slots go to the next anchor
+    delete a;
+
+    check(layout.getConstraintCount() == count,
+          "constraints of a destroyed anchor are removed");
+
+    Box c(0.0f, 0.0f);
+
+    for (const LayoutAttribute& attribute : attributes) {
+        const Expression expression = layout.getExpression(&c, attribute);
+
+        check(::std::count(released.begin(), released.end(),
+                           expression.getTerms().front().variable.id) == 1,
+              "variables of a destroyed anchor are reused");
+    }
+
+    layout.setWindowArea(::sf::FloatRect(0.0f, 0.0f, 400.0f, 300.0f));
+
+    check(layout.update() == 0, "unbound component is no longer moved");
+    check(near(b.getLeft(), 150.0) && near(b.getTop(), 100.0),
+          "unbound component keeps its position");
+
+    layout.addBinding(&c, &b, BindingPoint::TOP, BindingPoint::BOTTOM);
+    layout.addConstraint(layout.getExpression(&b, ATTRIBUTE_LEFT) - 150.0,
+                         EQUAL);
+    layout.addConstraint(layout.getExpression(&b, ATTRIBUTE_TOP) - 100.0,
+                         EQUAL);
+    layout.update();
+
+    check(near(c.getLeft(), 150.0) && near(c.getTop(), 120.0),
+          "anchor on reused variables is solved");
+
+    layout.remove(&c);
+    layout.remove(&b);
+
+    check(layout.getConstraintCount() == count,
+          "removed anchors take their constraints along");
+}
+
+int main() {
+    checkRequired();
+    checkInfeasibleInequality();
+    checkStrengths();
+    checkEdits();
+    checkRemoval();
+    checkRelease();
+    checkLayoutResize();
+    checkLayoutRemoval();
+
+    if (failures > 0) {
+        ::std::cerr << failures << " check(s) failed\n";
+        return 1;
+    }
+
+    ::std::cout << "All checks passed\n";
+
+    return 0;
+}